@@ -342,6 +342,27 @@ void libpd_paste(t_canvas* cnv, char const* buf)
     sys_unlock();
 }
 
+t_binbuf* libpd_copybinbuf(t_canvas* cnv)
+{
+    canvas_setcurrent(cnv);
+    pd_typedmess((t_pd*)cnv, gensym("copy"), 0, NULL);
+    canvas_unsetcurrent(cnv);
+
+    return binbuf_duplicate(pd_this->pd_gui->i_editor->copy_binbuf);
+}
+
+void libpd_pastebinbuf(t_canvas* cnv, t_binbuf* binbuf)
+{
+    sys_lock();
+    binbuf_clear(pd_this->pd_gui->i_editor->copy_binbuf);
+    binbuf_add(pd_this->pd_gui->i_editor->copy_binbuf, binbuf_getnatom(binbuf), binbuf_getvec(binbuf));
+
+    canvas_setcurrent(cnv);
+    pd_typedmess((t_pd*)cnv, gensym("paste"), 0, NULL);
+    canvas_unsetcurrent(cnv);
+    sys_unlock();
+}
+
 void libpd_undo(t_canvas* cnv)
 {
     sys_lock();
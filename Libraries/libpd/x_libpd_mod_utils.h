@@ -59,6 +59,10 @@ void libpd_moveobj(t_canvas* cnv, t_gobj* obj, int x, int y);
 char const* libpd_copy(t_canvas* cnv, int* size);
 void libpd_paste(t_canvas* cnv, char const*);
 
+// Same as copy and paste, but without converting the copy buffer to and from text
+t_binbuf* libpd_copybinbuf(t_canvas* cnv);
+void libpd_pastebinbuf(t_canvas* cnv, t_binbuf* binbuf);
+
 void libpd_duplicate(t_canvas* x);
 
 void libpd_undo(t_canvas* cnv);
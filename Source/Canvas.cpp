@@ -12,6 +12,8 @@
 #include "Canvas.h"
 #include "Object.h"
 #include "Connection.h"
+#include "ConnectionRouter.h"
+#include "ConnectionLayer.h"
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include "LookAndFeel.h"
@@ -34,6 +36,7 @@ Canvas::Canvas(PluginEditor* parent, pd::Patch::Ptr p, Component* parentGraph)
     , pd(parent->pd)
     , refCountedPatch(p)
     , patch(*p)
+    , connectionRouter(std::make_unique<ConnectionRouter>(this))
     , pathUpdater(new ConnectionPathUpdater(this))
     , graphArea(nullptr)
     , canvasOrigin(Point<int>(infiniteCanvasSize / 2, infiniteCanvasSize / 2))
@@ -116,6 +119,9 @@ Canvas::Canvas(PluginEditor* parent, pd::Patch::Ptr p, Component* parentGraph)
     addAndMakeVisible(&lasso);
     lasso.setAlwaysOnTop(true);
 
+    setConnectionLayerEnabled(SettingsFile::getInstance()->getProperty<bool>("batched_connections"));
+    lowDetailEnabled = SettingsFile::getInstance()->getProperty<bool>("low_detail_zoomed_out");
+
     setWantsKeyboardFocus(true);
 
     if (!isGraph) {
@@ -135,6 +141,9 @@ Canvas::Canvas(PluginEditor* parent, pd::Patch::Ptr p, Component* parentGraph)
 
     locked.addListener(this);
 
+    if (connectionLayer)
+        connectionLayer->updateLayering();
+
     editor->addModifierKeyListener(this);
     Desktop::getInstance().addFocusChangeListener(this);
 
@@ -154,6 +163,9 @@ Canvas::~Canvas()
 
     Desktop::getInstance().removeFocusChangeListener(this);
 
+    if (auto* paintProfiler = PaintProfiler::getInstanceWithoutCreating())
+        paintProfiler->removeOverlay(this);
+
     delete suggestor;
 }
 
@@ -167,6 +179,13 @@ void Canvas::propertyChanged(String const& name, var const& value)
         showBorder = static_cast<int>(value);
         repaint();
         break;
+    case hash("batched_connections"):
+        setConnectionLayerEnabled(static_cast<bool>(value));
+        break;
+    case hash("low_detail_zoomed_out"):
+        lowDetailEnabled = static_cast<bool>(value);
+        updateLowDetailMode();
+        break;
     case hash("edit"):
     case hash("lock"):
     case hash("run"):
@@ -208,6 +227,26 @@ void Canvas::moved()
 
 void Canvas::resized()
 {
+    if (connectionLayer)
+        connectionLayer->setBounds(getLocalBounds());
+}
+
+void Canvas::setConnectionLayerEnabled(bool shouldBeEnabled)
+{
+    // Graphs don't show connections
+    if (isGraph || shouldBeEnabled == (connectionLayer != nullptr))
+        return;
+
+    connectionLayer = shouldBeEnabled ? std::make_unique<ConnectionLayer>(this) : nullptr;
+
+    // Keep the lasso and graph area above the connections
+    lasso.toFront(false);
+    if (graphArea)
+        graphArea->toFront(false);
+
+    for (auto* connection : connections) {
+        connection->updateVisibility();
+    }
 }
 
 void Canvas::updateOverlays()
@@ -217,6 +256,18 @@ void Canvas::updateOverlays()
     showBorder = overlayState & Border;
     showOrigin = overlayState & Origin;
 
+    auto shouldShowPaintProfiler = !isGraph && (overlayState & PaintProfile);
+    if (shouldShowPaintProfiler != showPaintProfiler) {
+        showPaintProfiler = shouldShowPaintProfiler;
+        if (showPaintProfiler) {
+            PaintProfiler::getInstance()->addOverlay(this, [this](String const& report) {
+                pd->logMessage(report);
+            });
+        } else {
+            PaintProfiler::getInstance()->removeOverlay(this);
+        }
+    }
+
     for (auto* object : objects) {
         object->updateOverlays(overlayState);
     }
@@ -273,9 +324,38 @@ void Canvas::zoomToFitAll()
     viewport->setViewPosition(newViewPos);
 }
 
+bool Canvas::isLowDetail() const
+{
+    return lowDetailMode;
+}
+
+void Canvas::updateLowDetailMode()
+{
+    auto scale = getValue<float>(zoomScale);
+    auto threshold = lowDetailMode ? lowDetailZoomThreshold + lowDetailHysteresis : lowDetailZoomThreshold;
+    auto shouldBeLowDetail = lowDetailEnabled && !isGraph && scale < threshold;
+
+    if (shouldBeLowDetail == lowDetailMode)
+        return;
+
+    lowDetailMode = shouldBeLowDetail;
+
+    // Fade the object contents back in when zooming in, but only for objects that are on screen
+    auto viewArea = viewport ? viewport->getViewArea() / scale : getLocalBounds();
+    for (auto* object : objects) {
+        object->updateLowDetail(viewArea.intersects(object->getBounds()));
+    }
+
+    // Connections and labels check the level of detail while painting
+    repaint();
+}
+
 void Canvas::lookAndFeelChanged()
 {
     lasso.setColour(LassoComponent<Object>::lassoFillColourId, findColour(PlugDataColour::objectSelectedOutlineColourId).withAlpha(0.3f));
+
+    // Theme changed, so the grid tiles need to be rendered again
+    gridTile = Image();
 }
 
 void Canvas::paint(Graphics& g)
@@ -283,6 +363,8 @@ void Canvas::paint(Graphics& g)
     if (isGraph)
         return;
 
+    PaintProfiler::startPaint(paintStatistics);
+
     g.fillAll(findColour(PlugDataColour::canvasBackgroundColourId));
 
     if (viewport)
@@ -303,26 +385,25 @@ void Canvas::paint(Graphics& g)
     clippedOrigin.x += fmod(originDiff.x, 10.0f) - 0.5f;
     clippedOrigin.y += fmod(originDiff.y, 10.0f) - 0.5f;
 
-    if (!getValue<bool>(locked)) {
+    auto dotsColour = findColour(PlugDataColour::canvasDotsColourId);
+    updateGridTiles(g.getInternalContext().getPhysicalPixelScaleFactor(), dotsColour);
 
-        auto startX = (canvasOrigin.x % objectGrid.gridSize);
-        startX += ((clipBounds.getX() / objectGrid.gridSize) * objectGrid.gridSize);
+    // The tiles are rendered at the physical pixel scale, so they can be blitted without resampling
+    g.setImageResamplingQuality(Graphics::lowResamplingQuality);
 
-        auto startY = (canvasOrigin.y % objectGrid.gridSize);
-        startY += ((clipBounds.getY() / objectGrid.gridSize) * objectGrid.gridSize);
-
-        g.setColour(findColour(PlugDataColour::canvasDotsColourId));
-
-        for (int x = startX; x < clipBounds.getRight(); x += objectGrid.gridSize) {
-            for (int y = startY; y < clipBounds.getBottom(); y += objectGrid.gridSize) {
-
-                // Don't draw over origin line
-                if (showBorder || showOrigin) {
-                    if ((x == canvasOrigin.x && y >= canvasOrigin.y && y <= patchHeightCanvas) || (y == canvasOrigin.y && x >= canvasOrigin.x && x <= patchWidthCanvas))
-                        continue;
-                }
-                g.fillRect(static_cast<float>(x) - 0.5f, static_cast<float>(y) - 0.5f, 1.0, 1.0);
-            }
+    if (!getValue<bool>(locked)) {
+        auto gridSize = static_cast<float>(objectGrid.gridSize);
+        auto tileScale = gridSize / static_cast<float>(gridTile.getWidth() / gridTileCells);
+
+        // A tiled image fill replaces a fillRect call for every grid point
+        g.setFillType(FillType(gridTile, AffineTransform::scale(tileScale).translated(canvasOrigin.x - 0.5f, canvasOrigin.y - 0.5f)));
+        g.fillRect(clipBounds);
+
+        // Don't draw dots under the origin lines
+        if (showBorder || showOrigin) {
+            g.setColour(findColour(PlugDataColour::canvasBackgroundColourId));
+            g.fillRect(Rectangle<float>(canvasOrigin.x - 0.5f, canvasOrigin.y - 0.5f, 1.0f, patchHeightCanvas - canvasOrigin.y + 1.0f));
+            g.fillRect(Rectangle<float>(canvasOrigin.x - 0.5f, canvasOrigin.y - 0.5f, patchWidthCanvas - canvasOrigin.x + 1.0f, 1.0f));
         }
     }
 
@@ -358,20 +439,111 @@ void Canvas::paint(Graphics& g)
         extentLeft = Line<float>(pointA, pointOriginD);
     }
 
-    float dash[2] = { 5.0f, 5.0f };
+    // Dashed lines are drawn as a single rectangle with a tiled dash image, instead of a draw call per dash
+    auto drawDashedLine = [this, &g](Line<float> line) {
+        auto start = line.getStart();
+        auto end = line.getEnd();
+        auto bounds = Rectangle<float>(start, end);
 
-    g.setColour(findColour(PlugDataColour::canvasDotsColourId));
+        if (start.y == end.y) {
+            // The dash pattern starts at the start point, so reverse the phase if the line is drawn backwards
+            auto phase = start.x <= end.x ? start.x : start.x - 5.0f;
+            auto transform = AffineTransform::scale(10.0f / dashTiles[0].getWidth(), 1.0f / dashTiles[0].getHeight()).translated(phase, start.y - 0.5f);
+            g.setFillType(FillType(dashTiles[0], transform));
+            g.fillRect(bounds.withHeight(1.0f).translated(0.0f, -0.5f));
+        } else {
+            auto phase = start.y <= end.y ? start.y : start.y - 5.0f;
+            auto transform = AffineTransform::scale(1.0f / dashTiles[1].getWidth(), 10.0f / dashTiles[1].getHeight()).translated(start.x - 0.5f, phase);
+            g.setFillType(FillType(dashTiles[1], transform));
+            g.fillRect(bounds.withWidth(1.0f).translated(-0.5f, 0.0f));
+        }
+    };
 
-    g.drawDashedLine(extentLeft, dash, 2, 1.0f);
-    g.drawDashedLine(extentTop, dash, 2, 1.0f);
+    drawDashedLine(extentLeft);
+    drawDashedLine(extentTop);
 
     if (showBorder) {
         auto extentRight = Line<float>(pointC, pointB);
         auto extentBottom = Line<float>(pointC, pointD);
 
-        g.drawDashedLine(extentRight, dash, 2, 1.0f);
-        g.drawDashedLine(extentBottom, dash, 2, 1.0f);
+        drawDashedLine(extentRight);
+        drawDashedLine(extentBottom);
+    }
+}
+
+void Canvas::paintOverChildren(Graphics& g)
+{
+    if (isGraph)
+        return;
+
+    // Everything on the canvas has been painted now, so this is the time for a whole frame
+    if (paintStatistics.isMeasuring())
+        PaintProfiler::getInstance()->endPaint(paintStatistics, "Canvas", true);
+
+    if (showPaintProfiler)
+        paintProfilerOverlay(g);
+}
+
+void Canvas::paintProfilerOverlay(Graphics& g)
+{
+    auto clipBounds = g.getClipBounds();
+
+    for (auto* object : objectIndex.query(clipBounds)) {
+        auto bounds = object->getBounds().reduced(Object::margin);
+        g.setColour(PaintProfiler::getHeatColour(object->paintStatistics));
+        g.fillRect(bounds);
+
+        if (bounds.getWidth() > 60)
+            Fonts::drawText(g, PaintProfiler::getDescription(object->paintStatistics), bounds.withHeight(12).translated(0, -13), findColour(PlugDataColour::canvasTextColourId), 10, Justification::bottomLeft);
+    }
+
+    // Connections get a dot in the middle, filling their bounds would cover the objects
+    for (auto* connection : connectionIndex.query(clipBounds)) {
+        if (!connection->inlet || !connection->outlet)
+            continue;
+
+        auto centre = Line<float>(connection->getStartPoint(), connection->getEndPoint()).getPointAlongLineProportionally(0.5f);
+        g.setColour(PaintProfiler::getHeatColour(connection->paintStatistics).withAlpha(0.8f));
+        g.fillEllipse(Rectangle<float>(8, 8).withCentre(centre));
+    }
+
+    if (viewport) {
+        auto viewArea = viewport->getViewArea() / getValue<float>(zoomScale);
+        Fonts::drawText(g, "Canvas: " + PaintProfiler::getDescription(paintStatistics), viewArea.reduced(8).withHeight(16), findColour(PlugDataColour::canvasTextColourId), 13, Justification::topLeft);
+    }
+}
+
+void Canvas::updateGridTiles(float pixelScale, Colour colour)
+{
+    if (gridTile.isValid() && approximatelyEqual(pixelScale, gridTilePixelScale) && gridTileGridSize == objectGrid.gridSize && colour == gridTileColour)
+        return;
+
+    gridTilePixelScale = pixelScale;
+    gridTileGridSize = objectGrid.gridSize;
+    gridTileColour = colour;
+
+    auto dotSize = std::max(1, roundToInt(pixelScale));
+    auto cellSize = std::max(dotSize + 1, roundToInt(objectGrid.gridSize * pixelScale));
+
+    // Put multiple grid cells in one tile, so we don't end up blitting a tiny image many times
+    gridTileCells = std::max(1, 64 / cellSize);
+    gridTile = Image(Image::ARGB, cellSize * gridTileCells, cellSize * gridTileCells, true);
+    {
+        Graphics tileGraphics(gridTile);
+        tileGraphics.setColour(colour);
+        for (int x = 0; x < gridTileCells; x++) {
+            for (int y = 0; y < gridTileCells; y++) {
+                tileGraphics.fillRect(x * cellSize, y * cellSize, dotSize, dotSize);
+            }
+        }
     }
+
+    // One period of a 5px on, 5px off dash pattern, horizontal and vertical
+    auto dashLength = std::max(2, roundToInt(10.0f * pixelScale));
+    dashTiles[0] = Image(Image::ARGB, dashLength, dotSize, true);
+    dashTiles[1] = Image(Image::ARGB, dotSize, dashLength, true);
+    dashTiles[0].clear({ 0, 0, dashLength / 2, dotSize }, colour);
+    dashTiles[1].clear({ 0, 0, dotSize, dashLength / 2 }, colour);
 }
 
 TabComponent* Canvas::getTabbar()
@@ -444,6 +616,9 @@ void Canvas::synchroniseSplitCanvas()
 // Used for loading and for complicated actions like undo/redo
 void Canvas::performSynchronise()
 {
+    // Anything that asked for an asynchronous synchronise, like committing a transaction, is covered by this one
+    cancelPendingUpdate();
+
     pd->lockAudioThread();
 
     patch.setCurrent();
@@ -629,7 +804,13 @@ void Canvas::mouseDown(MouseEvent const& e)
     if (checkPanDragMode())
         return;
 
-    auto* source = e.originalComponent;
+    Component* source = e.originalComponent;
+
+    // Connections drawn by the connection layer don't receive mouse events themselves
+    if (connectionLayer) {
+        if (auto* connection = connectionLayer->handleMouseDown(e))
+            source = connection;
+    }
 
     // Left-click
     if (!e.mods.isRightButtonDown()) {
@@ -672,6 +853,9 @@ void Canvas::mouseDown(MouseEvent const& e)
 
 void Canvas::mouseDrag(MouseEvent const& e)
 {
+    if (connectionLayer)
+        connectionLayer->handleMouseDrag(e);
+
     if (canvasRateReducer.tooFast() || panningModifierDown())
         return;
 
@@ -690,8 +874,9 @@ void Canvas::mouseDrag(MouseEvent const& e)
         bool hasToggled = false;
 
         // Behaviour for dragging over toggles, bang and radiogroup to toggle them
-        for (auto* object : objects) {
-            if (!object->getBounds().contains(e.getEventRelativeTo(this).getPosition()) || !object->gui)
+        auto const position = e.getEventRelativeTo(this).getPosition();
+        for (auto* object : objectIndex.query(Rectangle<int>(position.x, position.y, 1, 1))) {
+            if (!object->getBounds().contains(position) || !object->gui)
                 continue;
 
             if (auto* obj = object->gui.get()) {
@@ -757,10 +942,12 @@ void Canvas::mouseUp(MouseEvent const& e)
     setPanDragMode(false);
     setMouseCursor(MouseCursor::NormalCursor);
 
+    bool releasedConnection = connectionLayer && connectionLayer->handleMouseUp(e);
+
     connectionCancelled = false;
 
     // Double-click canvas to create new object
-    if (e.mods.isLeftButtonDown() && (e.getNumberOfClicks() == 2) && (e.originalComponent == this) && !isGraph && !getValue<bool>(locked)) {
+    if (e.mods.isLeftButtonDown() && (e.getNumberOfClicks() == 2) && (e.originalComponent == this) && !releasedConnection && !isGraph && !getValue<bool>(locked)) {
         objects.add(new Object(this, "", lastMousePosition));
         deselectAll();
         setSelected(objects[objects.size() - 1], true); // Select newly created object
@@ -816,6 +1003,9 @@ void Canvas::mouseMove(MouseEvent const& e)
 {
     // TODO: can we get rid of this?
     lastMousePosition = getMouseXYRelative();
+
+    if (connectionLayer)
+        connectionLayer->handleMouseMove(e);
 }
 
 bool Canvas::keyPressed(KeyPress const& key)
@@ -944,15 +1134,25 @@ void Canvas::dragAndDropPaste(String const& patchString, Point<int> mousePos, in
             _this->grabKeyboardFocus();
     });
 
-    patch.startUndoSequence("DragAndDropPaste"); // TODO: we can add the name of the event that it's dragging from?
+    // Suspend DSP once for the whole paste, instead of for every object in it
+    patch.startTransaction("DragAndDropPaste"); // TODO: we can add the name of the event that it's dragging from?
 
     auto patchSize = Point<int>(patchWidth, patchHeight);
-    String translatedObjects = pd::Patch::translatePatchAsString(patchString, mousePos - (patchSize / 2.0f));
 
     if (auto patchPtr = patch.getPointer()) {
-        libpd_paste(patchPtr.get(), translatedObjects.toRawUTF8());
+        patch.setCurrent();
+
+        // Parse once, then move the objects without going back to text
+        pd::Clipboard toPaste;
+        toPaste.setContent(pd, patchString);
+        toPaste.translateTo(mousePos - (patchSize / 2.0f));
+
+        libpd_pastebinbuf(patchPtr.get(), toPaste.getBinbuf());
     }
 
+    // Only hold the Pd lock for the paste itself, not while creating the GUI objects
+    patch.commitTransaction();
+
     deselectAll();
 
     // Load state from pd
@@ -960,32 +1160,26 @@ void Canvas::dragAndDropPaste(String const& patchString, Point<int> mousePos, in
 
     patch.setCurrent();
 
-    std::vector<void*> pastedObjects;
-
-    auto* patchPtr = patch.getPointer().get();
-    if (!patchPtr)
-        return;
-
-    pd->lockAudioThread();
-    for (auto* object : objects) {
-        auto* objectPtr = static_cast<t_gobj*>(object->getPointer());
-        if (objectPtr && glist_isselected(patchPtr, objectPtr)) {
-            setSelected(object, true);
-            pastedObjects.emplace_back(objectPtr);
+    // The pasted objects are still selected in pd
+    if (auto* patchPtr = patch.getPointer().get()) {
+        pd->lockAudioThread();
+        for (auto* object : objects) {
+            auto* objectPtr = static_cast<t_gobj*>(object->getPointer());
+            if (objectPtr && glist_isselected(patchPtr, objectPtr)) {
+                setSelected(object, true);
+            }
         }
+        pd->unlockAudioThread();
     }
-    pd->unlockAudioThread();
 
     patch.deselectAll();
-    pastedObjects.clear();
-    patch.endUndoSequence("DragAndDropPaste");
 
     updateSidebarSelection();
 }
 
 void Canvas::pasteSelection()
 {
-    patch.startUndoSequence("Paste");
+    patch.startTransaction("Paste");
 
     // Paste at mousePos, adds padding if pasted the same place
     if (lastMousePosition == pastedPosition) {
@@ -998,6 +1192,9 @@ void Canvas::pasteSelection()
     // Tell pd to paste with offset applied to the clipboard string
     patch.paste(Point<int>(pastedPosition.x + pastedPadding.x, pastedPosition.y + pastedPadding.y));
 
+    // Only hold the Pd lock for the paste itself, not while creating the GUI objects
+    patch.commitTransaction();
+
     deselectAll();
 
     // Load state from pd
@@ -1005,25 +1202,19 @@ void Canvas::pasteSelection()
 
     patch.setCurrent();
 
-    std::vector<void*> pastedObjects;
-
-    auto* patchPtr = patch.getPointer().get();
-    if (!patchPtr)
-        return;
-
-    pd->lockAudioThread();
-    for (auto* object : objects) {
-        auto* objectPtr = static_cast<t_gobj*>(object->getPointer());
-        if (objectPtr && glist_isselected(patchPtr, objectPtr)) {
-            setSelected(object, true);
-            pastedObjects.emplace_back(objectPtr);
+    // The pasted objects are still selected in pd
+    if (auto* patchPtr = patch.getPointer().get()) {
+        pd->lockAudioThread();
+        for (auto* object : objects) {
+            auto* objectPtr = static_cast<t_gobj*>(object->getPointer());
+            if (objectPtr && glist_isselected(patchPtr, objectPtr)) {
+                setSelected(object, true);
+            }
         }
+        pd->unlockAudioThread();
     }
-    pd->unlockAudioThread();
 
     patch.deselectAll();
-    pastedObjects.clear();
-    patch.endUndoSequence("Paste");
 
     updateSidebarSelection();
 }
@@ -1033,17 +1224,24 @@ void Canvas::duplicateSelection()
     Array<Connection*> conInlets, conOutlets;
     auto selection = getSelectionOfType<Object>();
 
+    for (auto* object : selection) {
+        // Check if object exists in pd and is not attached to mouse
+        if (!object->getPointer() || object->attachedToMouse)
+            return;
+    }
+
+    // The duplicate and the auto patching after it are undone together
     patch.startUndoSequence("Duplicate");
 
+    // Only hold the Pd lock while duplicating, not while creating the GUI objects
+    patch.startTransaction("Duplicate");
+
     // clear all previous selections from pd
     patch.deselectAll();
 
     for (auto* object : selection) {
 
         auto* ptr = object->getPointer();
-        // Check if object exists in pd and is not attached to mouse
-        if (!ptr || object->attachedToMouse)
-            return;
 
         // Tell pd to select all objects that are currently selected
         patch.selectObject(ptr);
@@ -1064,22 +1262,24 @@ void Canvas::duplicateSelection()
     // Tell pd to duplicate
     patch.duplicate();
 
+    patch.commitTransaction();
+
     deselectAll();
 
     // Load state from pd immediately
     performSynchronise();
 
-    auto* patchPtr = patch.getPointer().get();
-    if (!patchPtr)
-        return;
-
     // Store the duplicated objects for later selection
     Array<Object*> duplicated;
-    for (auto* object : objects) {
-        auto* objectPtr = static_cast<t_gobj*>(object->getPointer());
-        if (objectPtr && glist_isselected(patchPtr, objectPtr)) {
-            duplicated.add(object);
+    if (auto* patchPtr = patch.getPointer().get()) {
+        pd->lockAudioThread();
+        for (auto* object : objects) {
+            auto* objectPtr = static_cast<t_gobj*>(object->getPointer());
+            if (objectPtr && glist_isselected(patchPtr, objectPtr)) {
+                duplicated.add(object);
+            }
         }
+        pd->unlockAudioThread();
     }
 
     // Auto patching
@@ -1182,7 +1382,7 @@ void Canvas::removeSelection()
 
 void Canvas::removeSelectedConnections()
 {
-    patch.startUndoSequence("Remove Connections");
+    patch.startTransaction("Remove Connections");
 
     for (auto* con : connections) {
         if (con->isSelected()) {
@@ -1190,10 +1390,8 @@ void Canvas::removeSelectedConnections()
         }
     }
 
-    patch.endUndoSequence("Remove Connections");
-
-    // Load state from pd
-    synchronise();
+    // Committing will synchronise this canvas
+    patch.commitTransaction();
     handleUpdateNowIfNeeded();
 
     synchroniseSplitCanvas();
@@ -1599,6 +1797,8 @@ void Canvas::valueChanged(Value& v)
         // Without this, future calls to getViewPosition() will give wrong results
         viewport->resized();
 
+        updateLowDetailMode();
+
         // set and trigger the zoom label popup in the bottom left corner
         // TODO: move this to viewport, and have one per viewport?
         editor->setZoomLabelLevel(newScaleFactor);
@@ -1638,6 +1838,9 @@ void Canvas::valueChanged(Value& v)
             }
         }
 
+        if (connectionLayer)
+            connectionLayer->updateLayering();
+
         repaint();
 
         // Makes sure no objects keep keyboard focus after locking/unlocking
@@ -1654,6 +1857,9 @@ void Canvas::valueChanged(Value& v)
     else if (v.refersToSameSourceAs(presentationMode)) {
         deselectAll();
         commandLocked.setValue(presentationMode.getValue());
+
+        if (connectionLayer)
+            connectionLayer->updateVisibility();
     } else if (v.refersToSameSourceAs(hideNameAndArgs)) {
         if (!patch.getPointer())
             return;
@@ -1753,26 +1959,37 @@ bool Canvas::setPanDragMode(bool shouldPan)
 
 void Canvas::findLassoItemsInArea(Array<WeakReference<Component>>& itemsFound, Rectangle<int> const& area)
 {
-    for (auto* object : objects) {
+    auto const shouldDeselect = !ModifierKeys::getCurrentModifiers().isAnyModifierKeyDown();
+    std::unordered_set<Component*> found;
+
+    // Only look at the objects near the lasso
+    for (auto* object : objectIndex.query(area)) {
         if (area.intersects(object->getSelectableBounds())) {
             itemsFound.add(object);
-        } else if (!ModifierKeys::getCurrentModifiers().isAnyModifierKeyDown()) {
-            setSelected(object, false, false);
+            found.insert(object);
         }
     }
 
-    for (auto& con : connections) {
-        // If total bounds don't intersect, there can't be an intersection with the line
-        // This is cheaper than checking the path intersection, so do this first
-        if (!con->getBounds().intersects(lasso.getBounds())) {
-            setSelected(con, false, false);
-            continue;
-        }
-
+    // If total bounds don't intersect, there can't be an intersection with the line
+    // The spatial index already filters on that, which is cheaper than checking the path intersection
+    for (auto* con : connectionIndex.query(lasso.getBounds())) {
         // Check if path intersects with lasso
         if (con->intersects(lasso.getBounds().toFloat())) {
             itemsFound.add(con);
-        } else if (!ModifierKeys::getCurrentModifiers().isAnyModifierKeyDown()) {
+            found.insert(con);
+        }
+    }
+
+    // Deselect everything that's no longer inside the lasso
+    // Connections always get deselected, objects only when no modifier key is down
+    for (auto* object : getSelectionOfType<Object>()) {
+        if (shouldDeselect && !found.count(object)) {
+            setSelected(object, false, false);
+        }
+    }
+
+    for (auto* con : getSelectionOfType<Connection>()) {
+        if (!found.count(con) && (shouldDeselect || !con->getBounds().intersects(lasso.getBounds()))) {
             setSelected(con, false, false);
         }
     }
@@ -10,6 +10,8 @@
 #include "Utility/RateReducer.h" // move to impl
 #include "Utility/ModifierKeyListener.h"
 #include "Utility/CheckedTooltip.h"
+#include "Utility/SpatialIndex.h"
+#include "Utility/PaintProfiler.h"
 #include "Pd/MessageListener.h"
 #include "Pd/Patch.h"
 #include "Constants.h"
@@ -27,6 +29,8 @@ class Connection;
 class PluginEditor;
 class PluginProcessor;
 class ConnectionPathUpdater;
+class ConnectionRouter;
+class ConnectionLayer;
 class ConnectionBeingCreated;
 class TabComponent;
 
@@ -59,6 +63,7 @@ public:
 
     void lookAndFeelChanged() override;
     void paint(Graphics& g) override;
+    void paintOverChildren(Graphics& g) override;
 
     void mouseDown(MouseEvent const& e) override;
     void mouseDrag(MouseEvent const& e) override;
@@ -121,6 +126,9 @@ public:
     void jumpToOrigin();
     void zoomToFitAll();
 
+    // True when zoomed out so far that objects are drawn as plain rectangles and connections as straight lines
+    bool isLowDetail() const;
+
     bool autoscroll(MouseEvent const& e);
 
     // Multi-dragger functions
@@ -171,6 +179,16 @@ public:
     // Needs to be allocated before object and connection so they can deselect themselves in the destructor
     SelectedItemSet<WeakReference<Component>> selectedComponents;
 
+    // Bounds of all objects and connections, for hit-testing, lasso selection, snapping and connection routing
+    // Also needs to be allocated before objects and connections, because they remove themselves in the destructor
+    SpatialIndex<Object> objectIndex;
+    SpatialIndex<Connection> connectionIndex;
+
+    std::unique_ptr<ConnectionRouter> connectionRouter;
+
+    // Draws all connections in one pass instead of as separate components, if enabled in the settings
+    std::unique_ptr<ConnectionLayer> connectionLayer;
+
     OwnedArray<Object> objects;
     OwnedArray<Connection> connections;
     OwnedArray<ConnectionBeingCreated> connectionsBeingCreated;
@@ -183,6 +201,7 @@ public:
 
     bool showOrigin = false;
     bool showBorder = false;
+    bool showPaintProfiler = false;
 
     bool isGraph = false;
     bool hasParentCanvas = false;
@@ -222,8 +241,33 @@ public:
     inline static constexpr int infiniteCanvasSize = 128000;
 
 private:
+    void updateGridTiles(float pixelScale, Colour colour);
+
+    void setConnectionLayerEnabled(bool shouldBeEnabled);
+
+    void updateLowDetailMode();
+
+    void paintProfilerOverlay(Graphics& g);
+
     LassoComponent<WeakReference<Component>> lasso;
 
+    // Pre-rendered grid dots and dash patterns, only re-rendered when zoom, theme or grid size changes
+    Image gridTile;
+    Image dashTiles[2];
+    int gridTileCells = 1;
+    int gridTileGridSize = 0;
+    float gridTilePixelScale = 0.0f;
+    Colour gridTileColour;
+
+    // Below this zoom level, we switch to low detail drawing
+    // We switch back at a slightly higher zoom level, so it doesn't flicker when zooming around the threshold
+    static constexpr float lowDetailZoomThreshold = 0.5f;
+    static constexpr float lowDetailHysteresis = 0.05f;
+    bool lowDetailEnabled = true;
+    bool lowDetailMode = false;
+
+    PaintProfiler::Statistics paintStatistics;
+
     RateReducer canvasRateReducer = RateReducer(90);
 
     // Properties that can be shown in the inspector by right-clicking on canvas
@@ -10,6 +10,7 @@
 #include "Connection.h"
 
 #include "Canvas.h"
+#include "ConnectionLayer.h"
 #include "Iolet.h"
 #include "Object.h"
 #include "PluginProcessor.h"
@@ -81,6 +82,10 @@ Connection::~Connection()
 {
     cnv->pd->unregisterMessageListener(ptr.getRawUnchecked<void>(), this);
     cnv->selectedComponents.removeChangeListener(this);
+    cnv->connectionIndex.remove(this);
+
+    if (cnv->connectionLayer)
+        cnv->connectionLayer->repaint(getBounds());
 
     if (outlet) {
         outlet->repaint();
@@ -99,6 +104,35 @@ Connection::~Connection()
     }
 }
 
+void Connection::moved()
+{
+    if (cnv->connectionLayer) {
+        cnv->connectionLayer->repaint(cnv->connectionIndex.getBounds(this));
+        cnv->connectionLayer->repaint(getBounds());
+    }
+
+    cnv->connectionIndex.update(this, getBounds());
+}
+
+void Connection::resized()
+{
+    if (cnv->connectionLayer) {
+        cnv->connectionLayer->repaint(cnv->connectionIndex.getBounds(this));
+        cnv->connectionLayer->repaint(getBounds());
+    }
+
+    cnv->connectionIndex.update(this, getBounds());
+}
+
+void Connection::repaintConnection()
+{
+    if (cnv->connectionLayer) {
+        cnv->connectionLayer->repaint(getBounds());
+    } else {
+        repaint();
+    }
+}
+
 void Connection::changeListenerCallback(ChangeBroadcaster* source)
 {
     if (auto selectedItems = dynamic_cast<SelectedItemSet<WeakReference<Component>>*>(source))
@@ -108,15 +142,21 @@ void Connection::changeListenerCallback(ChangeBroadcaster* source)
 void Connection::valueChanged(Value& v)
 {
     if (v.refersToSameSourceAs(presentationMode)) {
-        setVisible(presentationMode != var(true) && !cnv->isGraph);
+        updateVisibility();
     }
 }
 
+void Connection::updateVisibility()
+{
+    // If the canvas has a connection layer, that will draw the connection instead
+    setVisible(!cnv->connectionLayer && presentationMode != var(true) && !cnv->isGraph);
+}
+
 void Connection::lookAndFeelChanged()
 {
     updatePath();
     resizeToFit();
-    repaint();
+    repaintConnection();
 }
 
 void Connection::pushPathState()
@@ -215,15 +255,19 @@ bool Connection::hitTest(int x, int y)
 
     Point<float> position = Point<float>(static_cast<float>(x), static_cast<float>(y));
 
-    Point<float> nearestPoint;
-    toDrawLocalSpace.getNearestPoint(position, nearestPoint);
-
     // Get outlet and inlet point
     auto pstart = getStartPoint();
     auto pend = getEndPoint();
 
+    Point<float> nearestPoint;
+    if (cnv->isLowDetail()) {
+        nearestPoint = Line<float>(pstart, pend).findNearestPointTo(position + getPosition().toFloat()) - getPosition().toFloat();
+    } else {
+        toDrawLocalSpace.getNearestPoint(position, nearestPoint);
+    }
+
     if (selectedFlag && (startReconnectHandle.contains(position) || endReconnectHandle.contains(position))) {
-        repaint();
+        repaintConnection();
         return true;
     }
 
@@ -278,8 +322,6 @@ void Connection::renderConnectionPath(Graphics& g,
     auto signalColour = cnv->findColour(PlugDataColour::signalColourId);
     auto handleColour = isSignal ? dataColour : signalColour;
 
-    auto connectionLength = connectionPath.getLength();
-
     if (isSelected) {
         baseColour = isSignal ? signalColour : dataColour;
     } else if (isMouseOver) {
@@ -325,6 +367,9 @@ void Connection::renderConnectionPath(Graphics& g,
     float arrowWidth = 8.0f;
     float arrowLength = 12.0f;
 
+    // Only measure the path if we need it, because this is also used to draw many connections at once
+    auto connectionLength = showDirection || (isSelected && isHovering) ? connectionPath.getLength() : 0.0f;
+
     if (showDirection && connectionLength > arrowLength * 2) {
         // get the center point of the connection path
         auto arrowCenter = connectionLength * 0.5f;
@@ -389,21 +434,23 @@ void Connection::updateOverlays(int overlay)
     showActiveState = overlay & Overlay::ActivationState;
     updatePath();
     resizeToFit();
-    repaint();
+    repaintConnection();
 }
 
 void Connection::forceUpdate()
 {
     updatePath();
     resizeToFit();
-    repaint();
+    repaintConnection();
 }
 
 void Connection::paint(Graphics& g)
 {
+    PaintProfiler::startPaint(paintStatistics);
+
     renderConnectionPath(g,
         cnv,
-        toDrawLocalSpace,
+        cnv->isLowDetail() ? getLowDetailPath(false) : toDrawLocalSpace,
         outlet != nullptr && outlet->isSignal,
         isMouseOver(),
         showDirection,
@@ -415,6 +462,9 @@ void Connection::paint(Graphics& g)
         getMultiConnectNumber(),
         getNumSignalChannels());
 
+    if (paintStatistics.isMeasuring())
+        PaintProfiler::getInstance()->endPaint(paintStatistics, "Connection");
+
     /* ENABLE_CONNECTION_GRAPHICS_DEBUGGING_REPAINT
         static Random rng;
 
@@ -436,6 +486,28 @@ void Connection::paint(Graphics& g)
     */
 }
 
+void Connection::paintOnCanvas(Graphics& g)
+{
+    PaintProfiler::startPaint(paintStatistics);
+
+    renderConnectionPath(g,
+        cnv,
+        cnv->isLowDetail() ? getLowDetailPath(true) : toDraw,
+        outlet != nullptr && outlet->isSignal,
+        isHovering,
+        showDirection,
+        showConnectionOrder,
+        selectedFlag,
+        cnv->getMouseXYRelative(),
+        isHovering,
+        getNumberOfConnections(),
+        getMultiConnectNumber(),
+        getNumSignalChannels());
+
+    if (paintStatistics.isMeasuring())
+        PaintProfiler::getInstance()->endPaint(paintStatistics, "Connection");
+}
+
 bool Connection::isSegmented() const
 {
     return segmented;
@@ -447,7 +519,7 @@ void Connection::setSegmented(bool isSegmented)
     pushPathState();
     updatePath();
     resizeToFit();
-    repaint();
+    repaintConnection();
 }
 
 void Connection::setSelected(bool shouldBeSelected)
@@ -456,7 +528,7 @@ void Connection::setSelected(bool shouldBeSelected)
         selectedFlag = shouldBeSelected;
         updatePath();
         resizeToFit();
-        repaint();
+        repaintConnection();
     }
 }
 
@@ -469,21 +541,24 @@ void Connection::mouseMove(MouseEvent const& e)
 {
     int n = getClosestLineIdx(e.getPosition().toFloat(), currentPlan);
 
+    // When drawn by the connection layer, the mouse is over the canvas instead of this component
+    Component* cursorTarget = cnv->connectionLayer ? static_cast<Component*>(cnv) : this;
+
     if (isSegmented() && currentPlan.size() > 2 && n > 0) {
         auto line = Line<float>(currentPlan[n - 1], currentPlan[n]);
 
         if (line.isVertical()) {
-            setMouseCursor(MouseCursor::LeftRightResizeCursor);
+            cursorTarget->setMouseCursor(MouseCursor::LeftRightResizeCursor);
         } else if (line.isHorizontal()) {
-            setMouseCursor(MouseCursor::UpDownResizeCursor);
+            cursorTarget->setMouseCursor(MouseCursor::UpDownResizeCursor);
         } else {
-            setMouseCursor(MouseCursor::NormalCursor);
+            cursorTarget->setMouseCursor(MouseCursor::NormalCursor);
         }
     } else {
-        setMouseCursor(MouseCursor::NormalCursor);
+        cursorTarget->setMouseCursor(MouseCursor::NormalCursor);
     }
 
-    repaint();
+    repaintConnection();
 }
 
 StringArray Connection::getMessageFormated()
@@ -530,14 +605,14 @@ void Connection::mouseEnter(MouseEvent const& e)
     isHovering = true;
     if (!outlet->isSignal)
         cnv->editor->connectionMessageDisplay->setConnection(this, e.getScreenPosition());
-    repaint();
+    repaintConnection();
 }
 
 void Connection::mouseExit(MouseEvent const& e)
 {
     cnv->editor->connectionMessageDisplay->setConnection(nullptr);
     isHovering = false;
-    repaint();
+    repaintConnection();
 }
 
 void Connection::mouseDown(MouseEvent const& e)
@@ -550,7 +625,7 @@ void Connection::mouseDown(MouseEvent const& e)
     }
 
     cnv->setSelected(this, true);
-    repaint();
+    repaintConnection();
 
     if (currentPlan.size() <= 2)
         return;
@@ -600,7 +675,7 @@ void Connection::mouseDrag(MouseEvent const& e)
         setBufferedToImage(false);
         updatePath();
         resizeToFit();
-        repaint();
+        repaintConnection();
     }
 }
 
@@ -758,7 +833,7 @@ void Connection::componentMovedOrResized(Component& component, bool wasMoved, bo
     if (currentPlan.size() <= 2) {
         updatePath();
         resizeToFit();
-        repaint();
+        repaintConnection();
         return;
     }
 
@@ -785,7 +860,17 @@ void Connection::componentMovedOrResized(Component& component, bool wasMoved, bo
 
     updatePath();
     resizeToFit();
-    repaint();
+    repaintConnection();
+}
+
+Path Connection::getLowDetailPath(bool inCanvasSpace) const
+{
+    auto offset = inCanvasSpace ? Point<float>() : getPosition().toFloat();
+
+    Path line;
+    line.startNewSubPath(getStartPoint() - offset);
+    line.lineTo(getEndPoint() - offset);
+    return line;
 }
 
 Point<float> Connection::getStartPoint() const
@@ -915,7 +1000,7 @@ void Connection::applyBestPath()
     findPath();
     updatePath();
     resizeToFit();
-    repaint();
+    repaintConnection();
 }
 
 void Connection::findPath()
@@ -926,172 +1011,37 @@ void Connection::findPath()
     auto pstart = getStartPoint();
     auto pend = getEndPoint();
 
-    auto pathStack = PathPlan();
-    auto bestPath = PathPlan();
-
-    pathStack.reserve(8);
-
-    auto numFound = 0;
-
-    float incrementX, incrementY;
-
-    auto distance = pstart.getDistanceFrom(pend);
-    auto distanceX = std::abs(pstart.x - pend.x);
-    auto distanceY = std::abs(pstart.y - pend.y);
-
-    int maxXResolution = std::clamp<int>(distanceX / 10, 6, 14);
-    int maxYResolution = std::clamp<int>(distanceY / 10, 6, 14);
-
-    int resolutionX = 6;
-    int resolutionY = 6;
-
-    auto obstacles = Array<Rectangle<float>>();
-    auto searchBounds = Rectangle<float>(pstart, pend);
-
-    for (auto* object : cnv->objects) {
-        if (object->getBounds().toFloat().intersects(searchBounds)) {
-            obstacles.add(object->getBounds().toFloat());
-        }
-    }
-
-    // Look for paths at an increasing resolution
-    while (!numFound && resolutionX < maxXResolution && distance > 40) {
-
-        // Find paths on a resolution*resolution lattice ObjectGrid
-        incrementX = std::max<float>(1, distanceX / resolutionX);
-        incrementY = std::max<float>(1, distanceY / resolutionY);
-
-        numFound = findLatticePaths(bestPath, pathStack, pend, pstart, { incrementX, incrementY });
-
-        if (resolutionX < maxXResolution)
-            resolutionX++;
-        if (resolutionY < maxXResolution)
-            resolutionY++;
-
-        if (resolutionX > maxXResolution || resolutionY > maxYResolution)
-            break;
+    PathPlan plan;
 
-        pathStack.clear();
+    // Very short connections don't need to be routed
+    if (pstart.getDistanceFrom(pend) > 40) {
+        plan = cnv->connectionRouter->findRoute(this, pstart, pend);
     }
 
-    PathPlan simplifiedPath;
-
-    bool direction;
-    if (!bestPath.empty()) {
-        simplifiedPath.push_back(bestPath.front());
-
-        direction = bestPath[0].x == bestPath[1].x;
-
-        if (!direction)
-            simplifiedPath.push_back(bestPath.front());
-
-        for (int n = 1; n < bestPath.size(); n++) {
-            if ((bestPath[n].x != bestPath[n - 1].x && direction) || (bestPath[n].y != bestPath[n - 1].y && !direction)) {
-                simplifiedPath.push_back(bestPath[n - 1]);
-                direction = !direction;
-            }
-        }
-
-        simplifiedPath.push_back(bestPath.back());
-
-        if (!direction)
-            simplifiedPath.push_back(bestPath.back());
-    } else {
+    if (plan.empty()) {
         if (pend.y < pstart.y) {
             int xHalfDistance = (pstart.x - pend.x) / 2;
 
-            simplifiedPath.push_back(pend); // double to make it draggable
-            simplifiedPath.push_back(pend);
-            simplifiedPath.emplace_back(pend.x + xHalfDistance, pend.y);
-            simplifiedPath.emplace_back(pend.x + xHalfDistance, pstart.y);
-            simplifiedPath.push_back(pstart);
-            simplifiedPath.push_back(pstart);
+            plan.push_back(pend); // double to make it draggable
+            plan.push_back(pend);
+            plan.emplace_back(pend.x + xHalfDistance, pend.y);
+            plan.emplace_back(pend.x + xHalfDistance, pstart.y);
+            plan.push_back(pstart);
+            plan.push_back(pstart);
         } else {
             int yHalfDistance = (pstart.y - pend.y) / 2;
-            simplifiedPath.push_back(pend);
-            simplifiedPath.emplace_back(pend.x, pend.y + yHalfDistance);
-            simplifiedPath.emplace_back(pstart.x, pend.y + yHalfDistance);
-            simplifiedPath.push_back(pstart);
+            plan.push_back(pend);
+            plan.emplace_back(pend.x, pend.y + yHalfDistance);
+            plan.emplace_back(pstart.x, pend.y + yHalfDistance);
+            plan.push_back(pstart);
         }
-    }
-    std::reverse(simplifiedPath.begin(), simplifiedPath.end());
 
-    currentPlan = simplifiedPath;
-
-    pushPathState();
-}
-
-int Connection::findLatticePaths(PathPlan& bestPath, PathPlan& pathStack, Point<float> pstart, Point<float> pend, Point<float> increment)
-{
-
-    auto obstacles = Array<Object*>();
-    auto searchBounds = Rectangle<float>(pstart, pend);
-
-    for (auto* object : cnv->objects) {
-        if (object->getBounds().toFloat().intersects(searchBounds)) {
-            obstacles.add(object);
-        }
-    }
-
-    // Stop after we've found a path
-    if (!bestPath.empty())
-        return 0;
-
-    // Add point to path
-    pathStack.push_back(pstart);
-
-    // Check if it intersects any object
-    if (pathStack.size() > 1 && straightLineIntersectsObject(Line<float>(pathStack.back(), *(pathStack.end() - 2)), obstacles)) {
-        return 0;
-    }
-
-    bool endVertically = pathStack[0].y > pend.y;
-
-    // Check if we've reached the destination
-    if (std::abs(pstart.x - pend.x) < (increment.x * 0.5) && std::abs(pstart.y - pend.y) < (increment.y * 0.5)) {
-        bestPath = pathStack;
-        return 1;
+        std::reverse(plan.begin(), plan.end());
     }
 
-    // Count the number of found paths
-    int count = 0;
-
-    // Get current stack to revert to after each trial
-    auto pathCopy = pathStack;
-
-    auto followLine = [this, &count, &pathCopy, &bestPath, &pathStack, &increment](Point<float> currentOutlet, Point<float> currentInlet, bool isX) {
-        auto& coord1 = isX ? currentOutlet.x : currentOutlet.y;
-        auto& coord2 = isX ? currentInlet.x : currentInlet.y;
-        auto& incr = isX ? increment.x : increment.y;
-
-        if (std::abs(coord1 - coord2) >= incr) {
-            coord1 > coord2 ? coord1 -= incr : coord1 += incr;
-            count += findLatticePaths(bestPath, pathStack, currentOutlet, currentInlet, increment);
-            pathStack = pathCopy;
-        }
-    };
-
-    // If we're halfway on the axis, change preferred direction by inverting search order
-    // This will make it do a staircase effect
-    if (endVertically) {
-        if (std::abs(pstart.y - pend.y) >= std::abs(pathStack[0].y - pend.y) * 0.5) {
-            followLine(pstart, pend, false);
-            followLine(pstart, pend, true);
-        } else {
-            followLine(pstart, pend, true);
-            followLine(pstart, pend, false);
-        }
-    } else {
-        if (std::abs(pstart.x - pend.x) >= std::abs(pathStack[0].x - pend.x) * 0.5) {
-            followLine(pstart, pend, true);
-            followLine(pstart, pend, false);
-        } else {
-            followLine(pstart, pend, false);
-            followLine(pstart, pend, true);
-        }
-    }
+    currentPlan = plan;
 
-    return count;
+    pushPathState();
 }
 
 bool Connection::intersectsObject(Object* object) const
@@ -1103,47 +1053,6 @@ bool Connection::intersectsObject(Object* object) const
         || toDraw.intersectsLine({ b.getBottomRight(), b.getTopRight() });
 }
 
-bool Connection::straightLineIntersectsObject(Line<float> toCheck, Array<Object*>& objects)
-{
-
-    for (auto const& object : objects) {
-        auto bounds = object->getBounds().expanded(1);
-
-        if (object == outobj || object == inobj || !bounds.intersects(getBounds()))
-            continue;
-
-        auto intersectV = [](Line<float> first, Line<float> second) {
-            if (first.getStartY() > first.getEndY()) {
-                first = { first.getEnd(), first.getStart() };
-            }
-
-            return first.getStartX() > second.getStartX() && first.getStartX() < second.getEndX() && second.getStartY() > first.getStartY() && second.getStartY() < first.getEndY();
-        };
-
-        auto intersectH = [](Line<float> first, Line<float> second) {
-            if (first.getStartX() > first.getEndX()) {
-                first = { first.getEnd(), first.getStart() };
-            }
-
-            return first.getStartY() > second.getStartY() && first.getStartY() < second.getEndY() && second.getStartX() > first.getStartX() && second.getStartX() < first.getEndX();
-        };
-
-        bool intersectsV = toCheck.isVertical() && (intersectV(toCheck, Line<float>(bounds.getTopLeft().toFloat(), bounds.getTopRight().toFloat())) || intersectV(toCheck, Line<float>(bounds.getBottomRight().toFloat(), bounds.getBottomLeft().toFloat())));
-
-        bool intersectsH = toCheck.isHorizontal() && (intersectH(toCheck, Line<float>(bounds.getTopRight().toFloat(), bounds.getBottomRight().toFloat())) || intersectH(toCheck, Line<float>(bounds.getTopLeft().toFloat(), bounds.getBottomLeft().toFloat())));
-        if (intersectsV || intersectsH) {
-            return true;
-        }
-
-        /*
-         if(bounds.toFloat().intersects(toCheck.toFloat())) {
-         return true;
-         } TODO: benchmark these two options */
-        // TODO: possible mark areas that have already been visited?
-    }
-    return false;
-}
-
 void ConnectionPathUpdater::timerCallback()
 {
     std::pair<Component::SafePointer<Connection>, t_symbol*> currentConnection;
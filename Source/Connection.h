@@ -16,8 +16,8 @@
 #include "Pd/MessageListener.h"
 #include "Utility/RateReducer.h"
 #include "Utility/ModifierKeyListener.h"
-
-using PathPlan = std::vector<Point<float>>;
+#include "Utility/PaintProfiler.h"
+#include "ConnectionRouter.h"
 
 class Canvas;
 class PathUpdater;
@@ -62,6 +62,14 @@ public:
 
     void paint(Graphics&) override;
 
+    // Paints the connection in canvas coordinates, used when the canvas has a connection layer
+    void paintOnCanvas(Graphics& g);
+
+    void updateVisibility();
+
+    void moved() override;
+    void resized() override;
+
     bool isSegmented() const;
     void setSegmented(bool segmented);
 
@@ -82,6 +90,8 @@ public:
     void mouseEnter(MouseEvent const& e) override;
     void mouseExit(MouseEvent const& e) override;
 
+    PaintProfiler::Statistics paintStatistics;
+
     Point<float> getStartPoint() const;
     Point<float> getEndPoint() const;
 
@@ -100,14 +110,11 @@ public:
     void componentMovedOrResized(Component& component, bool wasMoved, bool wasResized) override;
 
     // Pathfinding
-    int findLatticePaths(PathPlan& bestPath, PathPlan& pathStack, Point<float> start, Point<float> end, Point<float> increment);
-
     void findPath();
 
     void applyBestPath();
 
     bool intersectsObject(Object* object) const;
-    bool straightLineIntersectsObject(Line<float> toCheck, Array<Object*>& objects);
 
     void receiveMessage(String const& name, int argc, t_atom* argv) override;
 
@@ -118,6 +125,12 @@ public:
 private:
     void resizeToFit();
 
+    // Repaints the connection itself, or its area of the connection layer
+    void repaintConnection();
+
+    // Straight line from outlet to inlet, used instead of the full path when the canvas is zoomed out far
+    Path getLowDetailPath(bool inCanvasSpace) const;
+
     int getMultiConnectNumber();
     int getNumSignalChannels();
     int getNumberOfConnections();
@@ -156,6 +169,7 @@ private:
     String lastSelector;
 
     friend class ConnectionPathUpdater;
+    friend class ConnectionLayer;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Connection)
 };
 
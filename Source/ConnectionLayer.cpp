@@ -0,0 +1,153 @@
+/*
+ // Copyright (c) 2021-2023 Timothy Schoen
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "Utility/Config.h"
+
+#include "ConnectionLayer.h"
+
+#include "Canvas.h"
+#include "Connection.h"
+#include "Iolet.h"
+#include "LookAndFeel.h"
+
+ConnectionLayer::ConnectionLayer(Canvas* parent)
+    : cnv(parent)
+{
+    // Mouse events are handled by the canvas, and forwarded to the connections from there
+    setInterceptsMouseClicks(false, false);
+
+    cnv->addAndMakeVisible(this);
+    setBounds(cnv->getLocalBounds());
+    updateLayering();
+    updateVisibility();
+}
+
+void ConnectionLayer::updateLayering()
+{
+    if (getValue<bool>(cnv->locked)) {
+        setAlwaysOnTop(false);
+        toBack();
+    } else {
+        setAlwaysOnTop(true);
+        toFront(false);
+    }
+}
+
+void ConnectionLayer::updateVisibility()
+{
+    setVisible(cnv->presentationMode != var(true) && !cnv->isGraph);
+}
+
+ConnectionLayer::BatchGroup ConnectionLayer::getBatchGroup(Connection* connection)
+{
+    // Connections that have a different colour or extra decorations are drawn by themselves
+    if (connection->selectedFlag || connection->isHovering || connection->showDirection || connection->showConnectionOrder)
+        return NotBatched;
+
+    if (!connection->outlet->isSignal || !PlugDataLook::getUseDashedConnections())
+        return Plain;
+
+    return connection->getNumSignalChannels() > 1 ? DashedMultichannel : Dashed;
+}
+
+void ConnectionLayer::paint(Graphics& g)
+{
+    PaintProfiler::startPaint(paintStatistics);
+
+    auto clipBounds = g.getClipBounds();
+
+    Path batches[NumBatchGroups];
+    Array<Connection*> notBatched;
+
+    for (auto* connection : cnv->connectionIndex.query(clipBounds)) {
+        if (!connection->inlet || !connection->outlet)
+            continue;
+
+        auto group = getBatchGroup(connection);
+        if (group == NotBatched) {
+            notBatched.add(connection);
+        } else {
+            batches[group].addPath(cnv->isLowDetail() ? connection->getLowDetailPath(true) : connection->toDraw);
+        }
+    }
+
+    // The style only depends on whether the connection is a signal connection, and the number of channels
+    if (!batches[Plain].isEmpty())
+        Connection::renderConnectionPath(g, cnv, batches[Plain], false);
+
+    if (!batches[Dashed].isEmpty())
+        Connection::renderConnectionPath(g, cnv, batches[Dashed], true, false, false, false, false, {}, false, 0, 0, 1);
+
+    if (!batches[DashedMultichannel].isEmpty())
+        Connection::renderConnectionPath(g, cnv, batches[DashedMultichannel], true, false, false, false, false, {}, false, 0, 0, 2);
+
+    // Draw selected and hovered connections last, so they end up on top
+    for (auto* connection : notBatched) {
+        connection->paintOnCanvas(g);
+    }
+
+    if (paintStatistics.isMeasuring())
+        PaintProfiler::getInstance()->endPaint(paintStatistics, "Connection layer");
+}
+
+Connection* ConnectionLayer::getConnectionAt(Point<int> position)
+{
+    for (auto* connection : cnv->connectionIndex.query(Rectangle<int>(position, position).expanded(1))) {
+        auto localPosition = position - connection->getPosition();
+        if (connection->getLocalBounds().contains(localPosition) && connection->hitTest(localPosition.x, localPosition.y))
+            return connection;
+    }
+
+    return nullptr;
+}
+
+void ConnectionLayer::handleMouseMove(MouseEvent const& e)
+{
+    // Only hover connections when the mouse is directly on the canvas
+    auto* hoveredConnection = e.originalComponent == cnv ? getConnectionAt(e.getEventRelativeTo(cnv).getPosition()) : nullptr;
+
+    if (hoveredConnection != connectionUnderMouse.getComponent()) {
+        if (auto* previous = connectionUnderMouse.getComponent())
+            previous->mouseExit(e.getEventRelativeTo(previous));
+
+        connectionUnderMouse = hoveredConnection;
+
+        if (hoveredConnection)
+            hoveredConnection->mouseEnter(e.getEventRelativeTo(hoveredConnection));
+        else
+            cnv->setMouseCursor(MouseCursor::NormalCursor);
+    }
+
+    if (hoveredConnection)
+        hoveredConnection->mouseMove(e.getEventRelativeTo(hoveredConnection));
+}
+
+Connection* ConnectionLayer::handleMouseDown(MouseEvent const& e)
+{
+    connectionBeingDragged = e.originalComponent == cnv ? getConnectionAt(e.getEventRelativeTo(cnv).getPosition()) : nullptr;
+
+    if (auto* connection = connectionBeingDragged.getComponent())
+        connection->mouseDown(e.getEventRelativeTo(connection));
+
+    return connectionBeingDragged;
+}
+
+void ConnectionLayer::handleMouseDrag(MouseEvent const& e)
+{
+    if (auto* connection = connectionBeingDragged.getComponent())
+        connection->mouseDrag(e.getEventRelativeTo(connection));
+}
+
+bool ConnectionLayer::handleMouseUp(MouseEvent const& e)
+{
+    auto* connection = connectionBeingDragged.getComponent();
+    connectionBeingDragged = nullptr;
+
+    if (connection)
+        connection->mouseUp(e.getEventRelativeTo(connection));
+
+    return connection != nullptr;
+}
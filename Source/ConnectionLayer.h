@@ -0,0 +1,56 @@
+/*
+ // Copyright (c) 2021-2023 Timothy Schoen
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+
+#pragma once
+
+#include "Utility/PaintProfiler.h"
+
+class Canvas;
+class Connection;
+
+// Optional layer that draws all connections of a canvas in a single pass
+// When enabled, the Connection components are hidden, so they don't take part in component traversal
+// Connections are grouped by style, so most of them can be stroked together as one path
+// Mouse events are hit-tested against the canvas spatial index and forwarded to the connection under the mouse
+class ConnectionLayer : public Component {
+public:
+    explicit ConnectionLayer(Canvas* parent);
+
+    void paint(Graphics& g) override;
+
+    Connection* getConnectionAt(Point<int> position);
+
+    // Called by the canvas, position is relative to the canvas
+    void handleMouseMove(MouseEvent const& e);
+    Connection* handleMouseDown(MouseEvent const& e);
+    void handleMouseDrag(MouseEvent const& e);
+    bool handleMouseUp(MouseEvent const& e);
+
+    void updateVisibility();
+
+    // Like the connection components, the layer goes behind the objects when the canvas is locked
+    void updateLayering();
+
+private:
+    enum BatchGroup {
+        NotBatched = -1,
+        Plain = 0,
+        Dashed,
+        DashedMultichannel,
+        NumBatchGroups
+    };
+
+    BatchGroup getBatchGroup(Connection* connection);
+
+    Canvas* cnv;
+
+    Component::SafePointer<Connection> connectionUnderMouse;
+    Component::SafePointer<Connection> connectionBeingDragged;
+
+    PaintProfiler::Statistics paintStatistics;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConnectionLayer)
+};
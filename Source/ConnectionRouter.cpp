@@ -0,0 +1,212 @@
+/*
+ // Copyright (c) 2021-2023 Timothy Schoen
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "Utility/Config.h"
+#include "Utility/Fonts.h"
+
+#include "ConnectionRouter.h"
+#include "Canvas.h"
+#include "Object.h"
+#include "Connection.h"
+
+#include <queue>
+
+ConnectionRouter::ConnectionRouter(Canvas* parent)
+    : cnv(parent)
+{
+}
+
+PathPlan ConnectionRouter::findRoute(Connection* connection, Point<float> start, Point<float> end)
+{
+    auto* outobj = connection->outobj.get();
+    auto* inobj = connection->inobj.get();
+
+    if (!outobj || !inobj)
+        return {};
+
+    // Leave the outlet going down, and enter the inlet from above
+    auto const startStub = Point<float>(start.x, outobj->getBounds().getBottom() + stubLength);
+    auto const endStub = Point<float>(end.x, inobj->getY() - stubLength);
+
+    auto area = Rectangle<float>(startStub, endStub).getUnion(outobj->getBounds().toFloat()).getUnion(inobj->getBounds().toFloat()).expanded(searchMargin);
+
+    // Object bounds already include a margin around the visible object, so we can route over the edges
+    Array<Rectangle<float>> obstacles;
+    for (auto* object : cnv->objectIndex.query(area.getSmallestIntegerContainer())) {
+        obstacles.add(object->getBounds().toFloat());
+    }
+
+    // Build a sparse grid from the edges of all obstacles and the start and end points
+    std::vector<float> xs = { startStub.x, endStub.x, area.getX(), area.getRight() };
+    std::vector<float> ys = { startStub.y, endStub.y, area.getY(), area.getBottom() };
+
+    for (auto& obstacle : obstacles) {
+        xs.push_back(jlimit(area.getX(), area.getRight(), obstacle.getX()));
+        xs.push_back(jlimit(area.getX(), area.getRight(), obstacle.getRight()));
+        ys.push_back(jlimit(area.getY(), area.getBottom(), obstacle.getY()));
+        ys.push_back(jlimit(area.getY(), area.getBottom(), obstacle.getBottom()));
+    }
+
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+    std::sort(ys.begin(), ys.end());
+    ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+    int const numX = static_cast<int>(xs.size());
+    int const numY = static_cast<int>(ys.size());
+
+    auto indexOf = [](std::vector<float> const& coords, float value) {
+        return static_cast<int>(std::lower_bound(coords.begin(), coords.end(), value) - coords.begin());
+    };
+
+    auto nodeIndex = [numY](int x, int y) {
+        return x * numY + y;
+    };
+
+    // Mark the nodes and edges that are strictly inside an obstacle
+    // Because all obstacle edges are grid lines, an edge is either completely inside or completely outside an obstacle
+    std::vector<bool> nodeBlocked(numX * numY, false);
+    std::vector<bool> horizontalBlocked(numX * numY, false); // Edge from (x, y) to (x + 1, y)
+    std::vector<bool> verticalBlocked(numX * numY, false);   // Edge from (x, y) to (x, y + 1)
+
+    for (auto& obstacle : obstacles) {
+        int const x1 = indexOf(xs, jlimit(area.getX(), area.getRight(), obstacle.getX()));
+        int const x2 = indexOf(xs, jlimit(area.getX(), area.getRight(), obstacle.getRight()));
+        int const y1 = indexOf(ys, jlimit(area.getY(), area.getBottom(), obstacle.getY()));
+        int const y2 = indexOf(ys, jlimit(area.getY(), area.getBottom(), obstacle.getBottom()));
+
+        for (int x = x1; x <= x2; x++) {
+            for (int y = y1; y <= y2; y++) {
+                bool const insideX = x > x1 && x < x2;
+                bool const insideY = y > y1 && y < y2;
+
+                if (insideX && insideY)
+                    nodeBlocked[nodeIndex(x, y)] = true;
+                if (x < x2 && insideY)
+                    horizontalBlocked[nodeIndex(x, y)] = true;
+                if (y < y2 && insideX)
+                    verticalBlocked[nodeIndex(x, y)] = true;
+            }
+        }
+    }
+
+    int const startNode = nodeIndex(indexOf(xs, startStub.x), indexOf(ys, startStub.y));
+    int const endNode = nodeIndex(indexOf(xs, endStub.x), indexOf(ys, endStub.y));
+
+    if (nodeBlocked[startNode] || nodeBlocked[endNode])
+        return {};
+
+    // A* search, where the state is a node and the direction we arrived from (0 = horizontal, 1 = vertical)
+    auto const numStates = numX * numY * 2;
+    std::vector<float> cost(numStates, std::numeric_limits<float>::max());
+    std::vector<int> parent(numStates, -1);
+
+    auto heuristic = [&xs, &ys, &endStub, numY](int node) {
+        return std::abs(xs[node / numY] - endStub.x) + std::abs(ys[node % numY] - endStub.y);
+    };
+
+    using QueueItem = std::pair<float, int>;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+
+    // We leave the outlet vertically
+    cost[startNode * 2 + 1] = 0.0f;
+    queue.push({ heuristic(startNode), startNode * 2 + 1 });
+
+    int endState = -1;
+    while (!queue.empty()) {
+        auto [priority, state] = queue.top();
+        queue.pop();
+
+        int const node = state / 2;
+        int const direction = state % 2;
+
+        if (priority - heuristic(node) > cost[state] + 0.01f)
+            continue; // Already found a cheaper way here
+
+        if (node == endNode) {
+            if (direction == 1) {
+                endState = state;
+                break;
+            }
+
+            // We have to enter the inlet vertically, so arriving from the side takes one more corner
+            auto const verticalState = node * 2 + 1;
+            if (cost[state] + bendPenalty < cost[verticalState]) {
+                cost[verticalState] = cost[state] + bendPenalty;
+                parent[verticalState] = state;
+                queue.push({ cost[verticalState], verticalState });
+            }
+            continue;
+        }
+
+        int const x = node / numY;
+        int const y = node % numY;
+
+        auto tryMove = [&](int newX, int newY, int newDirection, bool blocked) {
+            if (newX < 0 || newY < 0 || newX >= numX || newY >= numY || blocked)
+                return;
+
+            int const newNode = nodeIndex(newX, newY);
+            if (nodeBlocked[newNode])
+                return;
+
+            // Don't turn back into the outlet or come into the inlet from below
+            if ((node == startNode || newNode == endNode) && newY < y)
+                return;
+
+            auto const newState = newNode * 2 + newDirection;
+            auto const newCost = cost[state] + std::abs(xs[newX] - xs[x]) + std::abs(ys[newY] - ys[y]) + (newDirection != direction ? bendPenalty : 0.0f);
+
+            if (newCost < cost[newState]) {
+                cost[newState] = newCost;
+                parent[newState] = state;
+                queue.push({ newCost + heuristic(newNode), newState });
+            }
+        };
+
+        tryMove(x + 1, y, 0, horizontalBlocked[nodeIndex(x, y)]);
+        tryMove(x - 1, y, 0, x > 0 && horizontalBlocked[nodeIndex(x - 1, y)]);
+        tryMove(x, y + 1, 1, verticalBlocked[nodeIndex(x, y)]);
+        tryMove(x, y - 1, 1, y > 0 && verticalBlocked[nodeIndex(x, y - 1)]);
+    }
+
+    if (endState < 0)
+        return {};
+
+    // Walk back, only keeping the corners
+    PathPlan plan = { end, endStub };
+    for (int state = endState; state >= 0; state = parent[state]) {
+        auto const node = state / 2;
+        auto const point = Point<float>(xs[node / numY], ys[node % numY]);
+
+        if (plan.size() >= 2) {
+            auto const& last = plan.back();
+            auto const& beforeLast = plan[plan.size() - 2];
+            if ((last.x == beforeLast.x && last.x == point.x) || (last.y == beforeLast.y && last.y == point.y)) {
+                plan.back() = point;
+                continue;
+            }
+        }
+
+        if (plan.back() != point)
+            plan.push_back(point);
+    }
+
+    // The route may leave the outlet stub in a straight line, then the stub isn't a corner
+    if (plan.size() >= 2) {
+        auto const& last = plan.back();
+        auto const& beforeLast = plan[plan.size() - 2];
+        if ((last.x == beforeLast.x && last.x == start.x) || (last.y == beforeLast.y && last.y == start.y))
+            plan.pop_back();
+    }
+
+    if (plan.back() != start)
+        plan.push_back(start);
+
+    std::reverse(plan.begin(), plan.end());
+
+    return plan;
+}
@@ -0,0 +1,38 @@
+/*
+ // Copyright (c) 2021-2023 Timothy Schoen
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+
+#pragma once
+
+using PathPlan = std::vector<Point<float>>;
+
+class Canvas;
+class Connection;
+
+// Finds orthogonal routes for segmented connections
+// Uses A* over a sparse grid made from the edges of the objects around the connection,
+// instead of searching a dense lattice
+// Routes are only planned when the user asks for it, so hand-made paths are never replaced
+class ConnectionRouter {
+public:
+    explicit ConnectionRouter(Canvas* parent);
+
+    // Returns an empty plan if there is no route
+    PathPlan findRoute(Connection* connection, Point<float> start, Point<float> end);
+
+private:
+    Canvas* cnv;
+
+    // Length of the straight bit that leaves the outlet and enters the inlet
+    static inline constexpr float stubLength = 4.0f;
+
+    // How far around the start and end points we'll look for a route
+    static inline constexpr float searchMargin = 60.0f;
+
+    // Extra cost for each corner, to prefer routes with fewer corners
+    static inline constexpr float bendPenalty = 30.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConnectionRouter)
+};
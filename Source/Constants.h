@@ -395,7 +395,8 @@ enum Overlay {
     Coordinate = 8,
     ActivationState = 16,
     Order = 32,
-    Direction = 64
+    Direction = 64,
+    PaintProfile = 128
 };
 
 enum OverlayItem {
@@ -404,7 +405,8 @@ enum OverlayItem {
     OverlayIndex,
     OverlayActivationState,
     OverlayDirection,
-    OverlayOrder
+    OverlayOrder,
+    OverlayPaintProfile
 };
 
 enum Align {
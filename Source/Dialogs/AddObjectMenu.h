@@ -57,6 +57,14 @@ public:
     {
         isHovering = true;
         repaint();
+
+        // Start rendering the drag image in the background, so it's likely ready when the user starts dragging
+        if (dragImage.image.isNull()) {
+            dragImage = editor->offlineRenderer.getPreviewAsync(substituteThemeColours(objectPatch), 2.0f, [_this = SafePointer(this)](ImageWithOffset const& preview) {
+                if (_this)
+                    _this->dragImage = preview;
+            });
+        }
     }
 
     void mouseExit(MouseEvent const& e) override
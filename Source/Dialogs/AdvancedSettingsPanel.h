@@ -7,6 +7,35 @@
 
 #pragma once
 
+#if JUCE_DEBUG
+// Shows the state of the drop shadow cache, to help tuning its size
+struct ShadowCacheStatistics : public PropertiesPanel::Property
+    , public Timer {
+    ShadowCacheStatistics()
+        : Property("Shadow cache")
+    {
+        startTimer(500);
+    }
+
+    void timerCallback() override
+    {
+        repaint();
+    }
+
+    void paint(Graphics& g) override
+    {
+        auto stats = StackShadow::getShadowCache().getStatistics();
+        auto text = String(stats.hits) + " hits, " + String(stats.misses) + " misses, " + String(stats.numImages) + " images, "
+            + String(stats.bytesUsed / 1024) + "/" + String(stats.byteBudget / 1024) + " KB";
+
+        auto bounds = getLocalBounds().removeFromRight(getWidth() / 2);
+        Fonts::drawTextWithTabularNumbers(g, text, bounds, findColour(PlugDataColour::panelTextColourId), 14, Justification::centred);
+
+        Property::paint(g);
+    }
+};
+#endif
+
 class AdvancedSettingsPanel : public Component
     , public Value::Listener {
 
@@ -55,12 +84,33 @@ public:
         autoPatchingValue.referTo(settingsFile->getPropertyAsValue("autoconnect"));
         otherProperties.add(new PropertiesPanel::BoolComponent("Enable auto patching", autoPatchingValue, { "No", "Yes" }));
 
+        dspCrossfadeValue.referTo(settingsFile->getPropertyAsValue("dsp_crossfade"));
+        otherProperties.add(new PropertiesPanel::BoolComponent("Crossfade on DSP graph rebuild", dspCrossfadeValue, { "No", "Yes" }));
+
+        batchedConnectionsValue.referTo(settingsFile->getPropertyAsValue("batched_connections"));
+        otherProperties.add(new PropertiesPanel::BoolComponent("Draw connections in a single layer", batchedConnectionsValue, { "No", "Yes" }));
+
+        lowDetailValue.referTo(settingsFile->getPropertyAsValue("low_detail_zoomed_out"));
+        otherProperties.add(new PropertiesPanel::BoolComponent("Simplify drawing when zoomed out", lowDetailValue, { "No", "Yes" }));
+
         scaleValue = settingsFile->getProperty<float>("global_scale");
         scaleValue.addListener(this);
         otherProperties.add(new PropertiesPanel::EditableComponent<float>("Global scale factor", scaleValue));
 
         propertiesPanel.addSection("Other", otherProperties);
 
+#if JUCE_DEBUG
+        Array<PropertiesPanel::Property*> debugProperties;
+
+        shadowCacheBudget = static_cast<int>(StackShadow::getShadowCache().getStatistics().byteBudget / (1024 * 1024));
+        shadowCacheBudget.addListener(this);
+
+        debugProperties.add(new ShadowCacheStatistics());
+        debugProperties.add(new PropertiesPanel::EditableComponent<int>("Shadow cache size (MB)", shadowCacheBudget));
+
+        propertiesPanel.addSection("Debug", debugProperties);
+#endif
+
         addAndMakeVisible(propertiesPanel);
     }
 
@@ -80,6 +130,12 @@ public:
         if (v.refersToSameSourceAs(showPalettesValue)) {
             editor->resized();
         }
+#if JUCE_DEBUG
+        if (v.refersToSameSourceAs(shadowCacheBudget)) {
+            auto megabytes = std::max(getValue<int>(shadowCacheBudget), 1);
+            StackShadow::getShadowCache().setByteBudget(static_cast<size_t>(megabytes) * 1024 * 1024);
+        }
+#endif
         if (v.refersToSameSourceAs(scaleValue)) {
             auto scale = std::clamp(getValue<float>(scaleValue), 0.5f, 2.5f);
             SettingsFile::getInstance()->setGlobalScale(scale);
@@ -97,6 +153,10 @@ public:
 
     Value showPalettesValue;
     Value autoPatchingValue;
+    Value dspCrossfadeValue;
+    Value batchedConnectionsValue;
+    Value lowDetailValue;
+    Value shadowCacheBudget;
     Value showAllAudioDeviceValues;
     Value nativeDialogValue;
 
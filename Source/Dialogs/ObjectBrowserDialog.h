@@ -5,6 +5,7 @@
  */
 
 #include <utility>
+#include <unordered_set>
 
 #include "Utility/BouncingViewport.h"
 #include "ObjectReferenceDialog.h"
@@ -406,8 +407,9 @@ class ObjectSearchComponent : public Component
     , public KeyListener {
 
 public:
-    explicit ObjectSearchComponent(pd::Library& library)
+    explicit ObjectSearchComponent(pd::Library& objectLibrary)
         : bouncer(listBox.getViewport())
+        , library(objectLibrary)
     {
         listBox.setModel(this);
         listBox.setRowHeight(28);
@@ -583,14 +585,20 @@ public:
         if (query.isEmpty())
             return;
 
-        for (auto& item : objectDescriptions) {
-            // Insert in front if the query matches a whole word
-            if (item.first.containsWholeWord(query) || item.second.containsWholeWord(query)) {
-                searchResult.insert(0, item.first);
+        std::unordered_set<String> found;
+
+        // Objects whose documentation matches the query, best matches first
+        for (auto& object : library.searchDocumentation(query)) {
+            if (objectDescriptions.count(object)) {
+                searchResult.add(object);
+                found.insert(object);
             }
-            // Insert in back if it contains the query
-            else if (item.first.containsIgnoreCase(query) || item.second.containsIgnoreCase(query)) {
-                searchResult.add(item.first);
+        }
+
+        // Then objects that only contain the query somewhere in their name, or that aren't documented
+        for (auto& [object, description] : objectDescriptions) {
+            if (!found.count(object) && object.containsIgnoreCase(query)) {
+                searchResult.add(object);
             }
         }
 
@@ -632,6 +640,8 @@ private:
     ListBox listBox;
     BouncingViewportAttachment bouncer;
 
+    pd::Library& library;
+
     Array<String> searchResult;
     TextEditor input;
     TextButton clearButton = TextButton(Icons::ClearText);
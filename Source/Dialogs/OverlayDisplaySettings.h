@@ -130,6 +130,10 @@ public:
         connectionLabel.setFont(Font(14));
         addAndMakeVisible(connectionLabel);
 
+        developerLabel.setText("Developer", dontSendNotification);
+        developerLabel.setFont(Font(14));
+        addAndMakeVisible(developerLabel);
+
         buttonGroups.add(new OverlaySelector(overlayTree, Origin, "origin", "Origin", "0,0 point of canvas"));
         buttonGroups.add(new OverlaySelector(overlayTree, Border, "border", "Border", "Plugin / window workspace size"));
         buttonGroups.add(new OverlaySelector(overlayTree, Index, "index", "Index", "Object index in patch"));
@@ -137,6 +141,7 @@ public:
         buttonGroups.add(new OverlaySelector(overlayTree, ActivationState, "activation_state", "Activity", "Show object activity"));
         buttonGroups.add(new OverlaySelector(overlayTree, Direction, "direction", "Direction", "Direction of connection"));
         buttonGroups.add(new OverlaySelector(overlayTree, Order, "order", "Order", "Trigger order of multiple outlets"));
+        buttonGroups.add(new OverlaySelector(overlayTree, PaintProfile, "paint_profile", "Paint profiler", "Paint time heatmap, and frame times in the console"));
 
         for (auto* buttonGroup : buttonGroups) {
             addAndMakeVisible(buttonGroup);
@@ -168,6 +173,10 @@ public:
         connectionLabel.setBounds(bounds.removeFromTop(labelHeight));
         buttonGroups[OverlayDirection]->setBounds(bounds.removeFromTop(itemHeight));
         buttonGroups[OverlayOrder]->setBounds(bounds.removeFromTop(itemHeight));
+
+        bounds.removeFromTop(spacing);
+        developerLabel.setBounds(bounds.removeFromTop(labelHeight));
+        buttonGroups[OverlayPaintProfile]->setBounds(bounds.removeFromTop(itemHeight));
         setSize(170, bounds.getY());
     }
 
@@ -190,7 +199,7 @@ public:
 private:
     static inline bool isShowing = false;
 
-    Label canvasLabel, objectLabel, connectionLabel;
+    Label canvasLabel, objectLabel, connectionLabel, developerLabel;
 
     enum OverlayState {
         AllOff = 0,
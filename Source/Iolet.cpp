@@ -34,8 +34,7 @@ Iolet::Iolet(Object* parent, bool inlet)
     presentationMode.referTo(object->cnv->presentationMode);
     presentationMode.addListener(this);
 
-    bool isPresenting = getValue<bool>(presentationMode);
-    setVisible(!isPresenting && !insideGraph);
+    updateVisibility();
 
     // Drawing circles is more expensive than you might think, especially because there can be a lot of iolets!
     setBufferedToImage(true);
@@ -333,7 +332,8 @@ void Iolet::createConnection()
     // Check if this is the start or end action of connecting
     if (!cnv->connectionsBeingCreated.isEmpty()) {
 
-        cnv->patch.startUndoSequence("Connecting");
+        // Creating many connections at once only rebuilds DSP once
+        cnv->patch.startTransaction("Connecting");
 
         for (auto& c : object->cnv->connectionsBeingCreated) {
 
@@ -362,15 +362,14 @@ void Iolet::createConnection()
                 auto inIdx = inlet->ioletIdx;
 
                 if (!outobj->getPointer() || !inobj->getPointer())
-                    return;
+                    continue;
 
                 cnv->patch.createConnection(outobj->getPointer(), outIdx, inobj->getPointer(), inIdx);
             }
         }
 
-        cnv->patch.endUndoSequence("Connecting");
-
-        cnv->synchronise(); // Load all newly created connection from pd patch!
+        // Committing will load all newly created connections from the pd patch
+        cnv->patch.commitTransaction();
 
     }
     // otherwise set this iolet as start of a connection
@@ -423,9 +422,9 @@ Array<Connection*> Iolet::getConnections()
 
 Iolet* Iolet::findNearestIolet(Canvas* cnv, Point<int> position, bool inlet, Object* boxToExclude)
 {
-    // Find all iolets
+    // Find all iolets of objects near the position
     Array<Iolet*> allEdges;
-    for (auto* object : cnv->objects) {
+    for (auto* object : cnv->objectIndex.query(Rectangle<int>(position, position).expanded(51))) {
         for (auto* iolet : object->iolets) {
             if (iolet->isInlet == inlet && iolet->object != boxToExclude) {
                 allEdges.add(iolet);
@@ -459,7 +458,7 @@ void Iolet::valueChanged(Value& v)
         repaint();
     }
     if (v.refersToSameSourceAs(presentationMode)) {
-        setVisible(!getValue<bool>(presentationMode) && !insideGraph && !hideIolet);
+        updateVisibility();
         repaint();
     }
 }
@@ -467,6 +466,11 @@ void Iolet::valueChanged(Value& v)
 void Iolet::setHidden(bool hidden)
 {
     hideIolet = hidden;
-    setVisible(!getValue<bool>(presentationMode) && !insideGraph && !hideIolet);
+    updateVisibility();
     repaint();
 }
+
+void Iolet::updateVisibility()
+{
+    setVisible(!getValue<bool>(presentationMode) && !insideGraph && !hideIolet && !object->cnv->isLowDetail());
+}
@@ -36,6 +36,9 @@ public:
 
     void setHidden(bool hidden);
 
+    // Iolets are hidden in presentation mode, inside graphs, and when the canvas is zoomed out far
+    void updateVisibility();
+
     void clearConnections();
     Array<Connection*> getConnections();
 
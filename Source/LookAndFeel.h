@@ -1219,7 +1219,7 @@ struct PlugDataLook : public LookAndFeel_V4 {
             g.setFont(font);
             g.setColour(label.findColour(Label::textColourId));
 
-            g.drawFittedText(label.getText(), textArea, label.getJustificationType(), 1, 1.0f);
+            Fonts::getGlyphCache().drawFittedText(g, font, label.getText(), textArea, label.getJustificationType(), 1, 1.0f);
 
             g.setColour(label.findColour(Label::outlineColourId).withMultipliedAlpha(alpha));
         } else if (label.isEnabled()) {
@@ -83,6 +83,7 @@ Object::~Object()
     }
 
     cnv->selectedComponents.removeChangeListener(this);
+    cnv->objectIndex.remove(this);
 }
 
 Rectangle<int> Object::getObjectBounds()
@@ -195,6 +196,10 @@ void Object::valueChanged(Value& v)
         if (gui) {
             gui->lock(cnv->isGraph || locked == var(true) || commandLocked == var(true));
         }
+
+        // Give animated objects another chance, they might have stopped animating
+        renderCacheDisabled = false;
+        updateRenderCache();
     }
 
     repaint();
@@ -362,7 +367,8 @@ void Object::setType(String const& newType, void* existingObject)
         gui->initialise();
         gui->lock(cnv->isGraph || locked == var(true) || commandLocked == var(true));
         gui->addMouseListener(this, true);
-        addAndMakeVisible(gui.get());
+        addChildComponent(gui.get());
+        gui->setVisible(!cnv->isLowDetail());
     }
 
     isHvccCompatible = checkIfHvccCompatible();
@@ -375,6 +381,7 @@ void Object::setType(String const& newType, void* existingObject)
     updateIolets();
     updateBounds();
     resized(); // If bounds haven't changed, we'll still want to update gui and iolets bounds
+    updateRenderCache();
 
     // Auto patching
     if (!attachedToMouse && getValue<bool>(cnv->editor->autoconnect) && numInputs && cnv->lastSelectedObject && cnv->lastSelectedObject->numOutputs) {
@@ -489,6 +496,10 @@ void Object::paintOverChildren(Graphics& g)
 
         Fonts::drawStyledText(g, text, indexBounds, findColour(PlugDataColour::objectSelectedOutlineColourId).contrasting(), Monospace, 10, Justification::centred);
     }
+
+    // Includes the time it took to paint the gui and iolets
+    if (paintStatistics.isMeasuring())
+        PaintProfiler::getInstance()->endPaint(paintStatistics, gui ? gui->getType() : String("Object"));
 }
 
 void Object::triggerOverlayActiveState()
@@ -512,6 +523,34 @@ void Object::triggerOverlayActiveState()
 
 void Object::paint(Graphics& g)
 {
+    PaintProfiler::startPaint(paintStatistics);
+
+    // If the cached image keeps getting invalidated, the object is animating and caching only adds work
+    if (getCachedComponentImage() != nullptr && !renderCacheDisabled) {
+        auto now = Time::getMillisecondCounter();
+        if (now - cachedRenderWindowStart > 1000) {
+            cachedRenderWindowStart = now;
+            cachedRendersInWindow = 0;
+        }
+
+        if (++cachedRendersInWindow > maxCachedRendersPerSecond) {
+            renderCacheDisabled = true;
+
+            // Can't remove the cached image while it's being painted
+            MessageManager::callAsync([_this = SafePointer(this)]() {
+                if (_this)
+                    _this->updateRenderCache();
+            });
+        }
+    }
+
+    // When zoomed out far, the text and gui would be too small to read anyway
+    if (cnv->isLowDetail() && !newObjectEditor) {
+        g.setColour(findColour(selectedFlag ? PlugDataColour::objectSelectedOutlineColourId : PlugDataColour::objectOutlineColourId));
+        g.fillRect(getLocalBounds().reduced(margin));
+        return;
+    }
+
     if ((showActiveState || isTimerRunning(2))) {
         g.setOpacity(activeStateAlpha);
         // show activation state glow
@@ -553,8 +592,44 @@ void Object::paint(Graphics& g)
     }
 }
 
+void Object::updateLowDetail(bool fadeIn)
+{
+    auto lowDetail = cnv->isLowDetail();
+
+    for (auto* iolet : iolets) {
+        iolet->updateVisibility();
+    }
+
+    if (gui) {
+        if (!lowDetail && fadeIn) {
+            Desktop::getInstance().getAnimator().fadeIn(gui.get(), 150);
+        } else {
+            gui->setVisible(!lowDetail);
+        }
+    }
+
+    repaint();
+}
+
+void Object::updateRenderCache()
+{
+    // In run mode, most objects never change how they look
+    // Caching them as an image means they don't have to be redrawn when something overlapping them repaints, like a meter next to them
+    // JUCE invalidates the image when the object or one of its children calls repaint, so value and property changes still show up
+    // The cached image is rendered at the current zoom scale, and re-rendered when that changes
+    auto isLocked = getValue<bool>(locked) || getValue<bool>(commandLocked);
+    setBufferedToImage(isLocked && gui && !cnv->isGraph && !renderCacheDisabled);
+}
+
+void Object::moved()
+{
+    cnv->objectIndex.update(this, getBounds());
+}
+
 void Object::resized()
 {
+    cnv->objectIndex.update(this, getBounds());
+
     setVisible(!((cnv->isGraph || cnv->presentationMode == var(true)) && gui && gui->hideInGraph()));
 
     if (gui) {
@@ -899,20 +974,18 @@ void Object::mouseUp(MouseEvent const& e)
         if (ds.objectSnappingInbetween) {
             auto* c = ds.connectionToSnapInbetween.getComponent();
 
-            cnv->patch.startUndoSequence("SnapInbetween");
+            cnv->patch.startTransaction("SnapInbetween");
 
             cnv->patch.removeConnection(c->outobj->getPointer(), c->outIdx, c->inobj->getPointer(), c->inIdx, c->getPathState());
 
             cnv->patch.createConnection(c->outobj->getPointer(), c->outIdx, ds.objectSnappingInbetween->getPointer(), 0);
             cnv->patch.createConnection(ds.objectSnappingInbetween->getPointer(), 0, c->inobj->getPointer(), c->inIdx);
 
-            cnv->patch.endUndoSequence("SnapInbetween");
+            cnv->patch.commitTransaction();
 
             ds.objectSnappingInbetween->iolets[0]->isTargeted = false;
             ds.objectSnappingInbetween->iolets[ds.objectSnappingInbetween->numInputs]->isTargeted = false;
             ds.objectSnappingInbetween = nullptr;
-
-            cnv->synchronise();
         }
 
         if (ds.wasDragDuplicated) {
@@ -921,7 +994,7 @@ void Object::mouseUp(MouseEvent const& e)
         }
 
         for (auto* object : cnv->getSelectionOfType<Object>()) {
-            object->setBufferedToImage(false);
+            object->updateRenderCache();
             object->repaint();
         }
 
@@ -1194,6 +1267,9 @@ void Object::hideEditor()
 
         repaint();
         setType(newText);
+
+        // Objects that get created often are suggested first
+        cnv->pd->objectLibrary->recordUsage(newText.upToFirstOccurrenceOf(" ", false, false));
     }
 }
 
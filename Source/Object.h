@@ -10,6 +10,7 @@
 #include <JuceHeader.h>
 #include "Utility/SettingsFile.h"
 #include "Utility/RateReducer.h"
+#include "Utility/PaintProfiler.h"
 
 #define ACTIVITY_UPDATE_RATE 15
 
@@ -40,9 +41,16 @@ public:
     void paint(Graphics&) override;
     void paintOverChildren(Graphics&) override;
     void resized() override;
+    void moved() override;
 
     void updateIolets();
 
+    // Hides or shows the gui and iolets when the canvas switches level of detail
+    void updateLowDetail(bool fadeIn = false);
+
+    // Enables image caching in run mode, for objects that don't animate
+    void updateRenderCache();
+
     void setType(String const& newType, void* existingObject = nullptr);
     void updateBounds();
     void applyBounds();
@@ -107,6 +115,8 @@ public:
 
     Rectangle<int> originalBounds;
 
+    PaintProfiler::Statistics paintStatistics;
+
     static inline int const minimumSize = 12;
 
     bool isSelected() const;
@@ -132,6 +142,12 @@ private:
     bool showActiveState = false;
     float activeStateAlpha = 0.0f;
 
+    // Objects that re-render their cached image more often than this are treated as animated, and not cached
+    static constexpr int maxCachedRendersPerSecond = 20;
+    bool renderCacheDisabled = false;
+    int cachedRendersInWindow = 0;
+    uint32 cachedRenderWindowStart = 0;
+
     Image activityOverlayImage;
 
     ObjectDragState& ds;
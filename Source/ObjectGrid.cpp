@@ -485,9 +485,10 @@ Array<Object*> ObjectGrid::getSnappableObjects(Object* draggedObject)
     auto scaleFactor = std::sqrt(std::abs(cnv->getTransform().getDeterminant()));
     auto viewBounds = cnv->viewport.get()->getViewArea() / scaleFactor;
 
-    for (auto* object : cnv->objects) {
-        if (draggedObject == object || object->isSelected() || !viewBounds.intersects(object->getBounds()))
-            continue; // don't look at dragged object, selected objects, or objects that are outside of view bounds
+    // Only look at objects inside the view bounds
+    for (auto* object : cnv->objectIndex.query(viewBounds)) {
+        if (draggedObject == object || object->isSelected())
+            continue; // don't look at dragged object or selected objects
 
         snappable.add(object);
     }
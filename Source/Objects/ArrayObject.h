@@ -28,12 +28,12 @@ public:
         , object(parent)
     {
         vec.reserve(8192);
-        temp.reserve(8192);
         try {
             read(vec);
         } catch (...) {
             error = true;
         }
+        peaks.rebuild(vec.data(), vec.size());
 
         setInterceptsMouseClicks(true, false);
         setOpaque(false);
@@ -43,6 +43,16 @@ public:
         });
     }
 
+    ~GraphicalArray() override
+    {
+        // Edits made right before the dialog or object is closed haven't been written yet
+        if (pendingStart < pendingEnd) {
+            pd->lockAudioThread();
+            flushPendingWrites();
+            pd->unlockAudioThread();
+        }
+    }
+
     void setArray(void* array)
     {
         if (!array)
@@ -57,33 +67,11 @@ public:
         new (&arr) pd::WeakReference(array, pd);
     }
 
-    std::vector<float> rescale(std::vector<float> const& v, unsigned const newSize)
-    {
-        if (v.empty()) {
-            return {};
-        }
-
-        std::vector<float> result(newSize);
-        const std::size_t oldSize = v.size();
-        for (unsigned i = 0; i < newSize; i++) {
-            auto const idx = i * (oldSize - 1) / newSize;
-            auto const mod = i * (oldSize - 1) % newSize;
-
-            if (mod == 0)
-                result[i] = v[idx];
-            else {
-                float const part = float(mod) / float(newSize);
-                result[i] = v[idx] * (1.0 - part) + v[idx + 1] * part;
-            }
-        }
-        return result;
-    }
-
     void paintGraph(Graphics& g)
     {
         auto const h = static_cast<float>(getHeight());
         auto const w = static_cast<float>(getWidth());
-        std::vector<float> points = vec;
+        auto const& points = vec;
 
         if (!points.empty()) {
             std::array<float, 2> scale = getScale();
@@ -95,9 +83,10 @@ public:
             }
 
             // More than a point per pixel will cause insane loads, and isn't actually helpful
-            // Instead, linearly interpolate the vector to a max size of width in pixels
-            if (vec.size() >= w) {
-                points = rescale(points, w);
+            // Instead, draw the minimum and maximum of the samples under every pixel
+            if (points.size() > w) {
+                paintPeaks(g, scale, invert);
+                return;
             }
 
             float const dh = h / (scale[1] - scale[0]);
@@ -163,6 +152,51 @@ public:
         }
     }
 
+    // Draws the range of the samples under every column of pixels, using the min/max pyramid
+    // This takes about the same time for any array size, and only the columns inside the clip region are drawn
+    void paintPeaks(Graphics& g, std::array<float, 2> scale, bool invert)
+    {
+        auto const h = static_cast<float>(getHeight());
+        auto const w = getWidth();
+        auto const samplesPerPixel = static_cast<double>(vec.size()) / w;
+        auto const dh = h / (scale[1] - scale[0]);
+        auto const lineWidth = getLineWidth();
+
+        // Lines and curves connect to the next sample, so neighbouring columns overlap
+        auto const connected = getDrawType() != DrawType::Points;
+
+        auto toY = [&](float value) {
+            auto const y = h - (std::clamp(value, scale[0], scale[1]) - scale[0]) * dh;
+            return invert ? h - y : y;
+        };
+
+        auto const clip = g.getClipBounds();
+        auto const firstColumn = std::max(0, clip.getX());
+        auto const lastColumn = std::min(w, clip.getRight());
+
+        RectangleList<float> columns;
+        columns.ensureStorageAllocated(lastColumn - firstColumn);
+
+        for (int x = firstColumn; x < lastColumn; x++) {
+            auto const start = static_cast<size_t>(x * samplesPerPixel);
+            auto const end = std::max(start + 1, static_cast<size_t>((x + 1) * samplesPerPixel)) + connected;
+
+            auto const range = peaks.getRange(vec.data(), start, end);
+            if (range.isEmpty())
+                continue;
+
+            auto const y1 = toY(range.max);
+            auto const y2 = toY(range.min);
+            auto const top = std::min(y1, y2) - lineWidth / 2.0f;
+            auto const bottom = std::max(y1, y2) + lineWidth / 2.0f;
+
+            columns.addWithoutMerging({ static_cast<float>(x), top, 1.0f, bottom - top });
+        }
+
+        g.setColour(getContentColour());
+        g.fillRectList(columns);
+    }
+
     void paint(Graphics& g) override
     {
         if (error) {
@@ -176,7 +210,7 @@ public:
 
     void mouseDown(MouseEvent const& e) override
     {
-        if (error || !getEditMode())
+        if (error || !getEditMode() || vec.empty())
             return;
         edited = true;
 
@@ -186,12 +220,16 @@ public:
 
         lastIndex = std::round(std::clamp(x / w, 0.f, 1.f) * s);
 
+        strokeStart = lastIndex;
+        strokeEnd = lastIndex;
+        strokeBefore.clear();
+
         mouseDrag(e);
     }
 
     void mouseDrag(MouseEvent const& e) override
     {
-        if (error || !getEditMode())
+        if (error || !getEditMode() || !edited)
             return;
 
         auto const s = static_cast<float>(vec.size() - 1);
@@ -213,58 +251,213 @@ public:
         float min = index == interpStart ? current : start;
         float max = index == interpStart ? start : current;
 
+        extendStroke(interpStart, interpEnd + 1);
+
         // Fix to make sure we don't leave any gaps while dragging
         for (int n = interpStart; n <= interpEnd; n++) {
             vec[n] = jmap<float>(n, interpStart, interpEnd + 1, min, max);
         }
 
-        // Don't want to touch vec on the other thread, so we copy the vector into the lambda
-        auto changed = std::vector<float>(vec.begin() + interpStart, vec.begin() + interpEnd + 1);
-
         lastIndex = index;
 
-        pd->lockAudioThread();
-        for (int n = 0; n < changed.size(); n++) {
-            write(interpStart + n, changed[n]);
-        }
+        // Pd gets the changes on the next update, so a fast drag only causes one write per frame
+        peaks.update(vec.data(), vec.size(), interpStart, interpEnd + 1);
+        addPendingWrite(interpStart, interpEnd + 1);
+        repaintSamples(interpStart, interpEnd + 1);
+    }
 
-        if (auto ptr = arr.get<t_garray>()) {
-            pd->sendDirectMessage(ptr.get(), stringArray);
+    void mouseUp(MouseEvent const& e) override
+    {
+        if (error || !getEditMode() || !edited)
+            return;
+        edited = false;
+
+        if (strokeEnd > strokeStart) {
+            addUndoRecord({ strokeStart, std::move(strokeBefore), std::vector<float>(vec.begin() + strokeStart, vec.begin() + strokeEnd), nextEditSequence++ });
+            strokeBefore.clear();
         }
+    }
 
-        pd->unlockAudioThread();
-        repaint();
+    bool canUndo() const { return !undoHistory.empty(); }
+    bool canRedo() const { return !redoHistory.empty(); }
+
+    // Used to find the array that was edited last, when a dialog shows more than one
+    int64 getUndoSequence() const { return canUndo() ? undoHistory.back().sequence : -1; }
+    int64 getRedoSequence() const { return canRedo() ? redoHistory.back().sequence : -1; }
+
+    void undo()
+    {
+        if (!canUndo() || edited)
+            return;
+
+        auto record = std::move(undoHistory.back());
+        undoHistory.pop_back();
+        undoHistorySize -= record.before.size() + record.after.size();
+
+        applyEdit(record.start, record.before);
+        redoHistory.push_back(std::move(record));
     }
 
-    void mouseUp(MouseEvent const& e) override
+    void redo()
     {
-        if (error || !getEditMode())
+        if (!canRedo() || edited)
             return;
-        edited = false;
+
+        auto record = std::move(redoHistory.back());
+        redoHistory.pop_back();
+
+        applyEdit(record.start, record.after);
+        undoHistorySize += record.before.size() + record.after.size();
+        undoHistory.push_back(std::move(record));
     }
 
     void update()
     {
-        // Check if size has changed
+        // Check if size has changed, in which case we need to read everything again
+        // Edits that are still pending were made to the old array, so drop them instead of writing them
         int currentSize = size();
         if (vec.size() != currentSize) {
-            vec.resize(currentSize);
+            pendingStart = 0;
+            pendingEnd = 0;
+
+            undoHistory.clear();
+            redoHistory.clear();
+            undoHistorySize = 0;
+
+            error = false;
+            try {
+                read(vec);
+            } catch (...) {
+                error = true;
+            }
+            peaks.rebuild(vec.data(), vec.size());
+            scanPosition = 0;
+            repaint();
+            return;
         }
 
-        if (!edited) {
+        flushPendingWrites();
+
+        if (edited || vec.empty())
+            return;
+
+        // Pd doesn't tell us which part of the array was written to, so we compare the array with our copy in chunks
+        // Large arrays are compared over multiple updates, to keep the time we spend holding the audio lock short
+        // Only the chunks that changed are copied, and only the pixels showing them are repainted
+        auto samplesToScan = std::min(vec.size(), maxSamplesPerUpdate);
+        while (samplesToScan > 0) {
+            if (scanPosition >= vec.size())
+                scanPosition = 0;
+
+            auto const chunkStart = scanPosition;
+            auto const chunkSize = std::min({ scanChunkSize, samplesToScan, vec.size() - chunkStart });
+
             error = false;
             try {
-                read(temp);
+                read(scanBuffer, chunkStart, chunkSize);
             } catch (...) {
                 error = true;
+                return;
             }
-            if (temp != vec) {
-                vec.swap(temp);
-                repaint();
+
+            auto const* current = vec.data() + chunkStart;
+            if (std::memcmp(current, scanBuffer.data(), chunkSize * sizeof(float)) != 0) {
+                // Narrow it down to the samples that actually changed
+                // Compare the bits like above, otherwise -0.0 and NaN would never be copied
+                auto isUnchanged = [current, this](size_t i) {
+                    return std::memcmp(current + i, scanBuffer.data() + i, sizeof(float)) == 0;
+                };
+
+                size_t first = 0;
+                while (isUnchanged(first) && first < chunkSize - 1)
+                    first++;
+
+                size_t last = chunkSize;
+                while (isUnchanged(last - 1) && last > first + 1)
+                    last--;
+
+                std::copy(scanBuffer.begin() + first, scanBuffer.begin() + last, vec.begin() + chunkStart + first);
+                peaks.update(vec.data(), vec.size(), chunkStart + first, chunkStart + last);
+                repaintSamples(chunkStart + first, chunkStart + last);
             }
+
+            scanPosition += chunkSize;
+            samplesToScan -= chunkSize;
         }
     }
 
+    // Adds the samples in [start, end) to the samples that will be written to Pd on the next update
+    // Edits close to each other are merged into one span, so they only need a single write
+    void addPendingWrite(size_t start, size_t end)
+    {
+        if (pendingStart >= pendingEnd) {
+            pendingStart = start;
+            pendingEnd = end;
+        } else {
+            pendingStart = std::min(pendingStart, start);
+            pendingEnd = std::max(pendingEnd, end);
+        }
+    }
+
+    // Needs to be called with the audio thread locked
+    void flushPendingWrites()
+    {
+        if (pendingStart >= pendingEnd)
+            return;
+
+        // Writing past the end of the array would fail while holding the Pd lock, so check against the size in Pd too
+        if (pendingEnd <= vec.size() && pendingEnd <= static_cast<size_t>(size())) {
+            write(pendingStart, vec.data() + pendingStart, pendingEnd - pendingStart);
+
+            if (auto ptr = arr.get<t_garray>()) {
+                pd->sendDirectMessage(ptr.get(), stringArray);
+            }
+        }
+
+        pendingStart = 0;
+        pendingEnd = 0;
+    }
+
+    // Saves the values of the samples that the current stroke is about to change for the first time
+    // Strokes are contiguous, so we only need to grow the saved span at either end
+    void extendStroke(size_t start, size_t end)
+    {
+        if (start < strokeStart) {
+            strokeBefore.insert(strokeBefore.begin(), vec.begin() + start, vec.begin() + strokeStart);
+            strokeStart = start;
+        }
+        if (end > strokeEnd) {
+            strokeBefore.insert(strokeBefore.end(), vec.begin() + strokeEnd, vec.begin() + end);
+            strokeEnd = end;
+        }
+    }
+
+    void applyEdit(size_t start, std::vector<float> const& values)
+    {
+        auto const end = start + values.size();
+        if (end > vec.size())
+            return;
+
+        std::copy(values.begin(), values.end(), vec.begin() + start);
+        peaks.update(vec.data(), vec.size(), start, end);
+        addPendingWrite(start, end);
+        repaintSamples(start, end);
+    }
+
+    // Repaints the pixels showing the samples in [start, end), including the lines connecting them to their neighbours
+    void repaintSamples(size_t start, size_t end)
+    {
+        if (vec.empty())
+            return;
+
+        auto const w = static_cast<double>(getWidth());
+        auto const samples = static_cast<double>(vec.size());
+        auto const x1 = static_cast<int>(std::floor((start - 1.0) / samples * w)) - 2;
+        auto const x2 = static_cast<int>(std::ceil((end + 1.0) / samples * w)) + 2;
+
+        repaint(x1, 0, x2 - x1, getHeight());
+    }
+
     bool willSaveContent() const
     {
         if (auto ptr = arr.get<t_garray>()) {
@@ -402,6 +595,15 @@ public:
         }
     }
 
+    // Gets a part of the values of the array.
+    void read(std::vector<float>& output, size_t start, size_t numSamples) const
+    {
+        if (auto ptr = arr.get<t_garray>()) {
+            output.resize(numSamples);
+            libpd_array_read(output.data(), ptr.get(), static_cast<int>(start), static_cast<int>(numSamples));
+        }
+    }
+
     // Writes the values of the array.
     void write(std::vector<float> const& input)
     {
@@ -410,24 +612,64 @@ public:
         }
     }
 
-    // Writes a value of the array.
-    void write(const size_t pos, float const input)
+    // Writes a part of the values of the array.
+    void write(size_t start, float const* input, size_t numSamples)
     {
         if (auto ptr = arr.get<t_garray>()) {
-            libpd_array_write(ptr.get(), static_cast<int>(pos), &input, 1);
+            libpd_array_write(ptr.get(), static_cast<int>(start), input, static_cast<int>(numSamples));
         }
     }
 
     pd::WeakReference arr;
 
     std::vector<float> vec;
-    std::vector<float> temp;
+    std::vector<float> scanBuffer;
+    MinMaxPyramid peaks;
     std::atomic<bool> edited;
     bool error = false;
     const String stringArray = "array";
 
     int lastIndex = 0;
 
+    static constexpr size_t scanChunkSize = 4096;
+    static constexpr size_t maxSamplesPerUpdate = 1 << 18;
+    size_t scanPosition = 0;
+
+    size_t pendingStart = 0;
+    size_t pendingEnd = 0;
+
+    // Only the span of samples that a stroke changed is stored, with its values before and after the stroke
+    struct EditRecord {
+        size_t start;
+        std::vector<float> before;
+        std::vector<float> after;
+        int64 sequence;
+    };
+
+    void addUndoRecord(EditRecord&& record)
+    {
+        undoHistorySize += record.before.size() + record.after.size();
+        undoHistory.push_back(std::move(record));
+        redoHistory.clear();
+
+        // Forget the oldest strokes when the history gets too large, but always keep the last one
+        while (undoHistorySize > maxUndoHistorySize && undoHistory.size() > 1) {
+            undoHistorySize -= undoHistory.front().before.size() + undoHistory.front().after.size();
+            undoHistory.erase(undoHistory.begin());
+        }
+    }
+
+    static constexpr size_t maxUndoHistorySize = 1 << 22;
+    static inline int64 nextEditSequence = 0;
+
+    size_t strokeStart = 0;
+    size_t strokeEnd = 0;
+    std::vector<float> strokeBefore;
+
+    std::vector<EditRecord> undoHistory;
+    std::vector<EditRecord> redoHistory;
+    size_t undoHistorySize = 0;
+
     PluginProcessor* pd;
 };
 
@@ -474,9 +716,40 @@ public:
 
         addAndMakeVisible(resizer);
 
+        setWantsKeyboardFocus(true);
         startTimer(40);
     }
 
+    bool keyPressed(KeyPress const& key) override
+    {
+        if (key == KeyPress('z', ModifierKeys::commandModifier, 0)) {
+            // Undo the array that was edited last
+            GraphicalArray* lastEdited = nullptr;
+            for (auto* graph : graphs) {
+                if (graph->canUndo() && (!lastEdited || graph->getUndoSequence() > lastEdited->getUndoSequence()))
+                    lastEdited = graph;
+            }
+            if (lastEdited)
+                lastEdited->undo();
+
+            return true;
+        }
+        if (key == KeyPress('z', ModifierKeys::commandModifier | ModifierKeys::shiftModifier, 0) || key == KeyPress('y', ModifierKeys::commandModifier, 0)) {
+            // Redo the array that was undone last
+            GraphicalArray* lastUndone = nullptr;
+            for (auto* graph : graphs) {
+                if (graph->canRedo() && (!lastUndone || graph->getRedoSequence() < lastUndone->getRedoSequence()))
+                    lastUndone = graph;
+            }
+            if (lastUndone)
+                lastUndone->redo();
+
+            return true;
+        }
+
+        return false;
+    }
+
     void resized() override
     {
         resizer.setBounds(getLocalBounds());
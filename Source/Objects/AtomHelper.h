@@ -317,7 +317,7 @@ public:
         auto objectBounds = object->getBounds().reduced(Object::margin);
         int fontHeight = getAtomHeight() - 6;
 
-        int labelLength = Font(fontHeight).getStringWidth(getExpandedLabelText());
+        int labelLength = roundToInt(Fonts::getGlyphCache().getStringWidth(Font(fontHeight), getExpandedLabelText()));
 
         int labelPosition;
         if (auto atom = ptr.get<t_fake_gatom>()) {
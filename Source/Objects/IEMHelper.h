@@ -312,7 +312,7 @@ public:
             t_symbol const* sym = canvas_realizedollar(iemgui->x_glist, iemgui->x_lab);
             if (sym) {
                 int fontHeight = getFontHeight();
-                int labelLength = Font(fontHeight).getStringWidth(getExpandedLabelText());
+                int labelLength = roundToInt(Fonts::getGlyphCache().getStringWidth(Font(fontHeight), getExpandedLabelText()));
 
                 int const posx = objectBounds.getX() + iemgui->x_ldx + 4;
                 int const posy = objectBounds.getY() + iemgui->x_ldy;
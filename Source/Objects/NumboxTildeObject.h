@@ -10,6 +10,7 @@ class NumboxTildeObject final : public ObjectBase
     , public Timer {
 
     DraggableNumber input;
+    ValueTap tap;
 
     int nextInterval = 100;
     std::atomic<int> mode = 0;
@@ -53,6 +54,14 @@ public:
             }
         };
 
+        // Mode, interval, displayed value and input value
+        tap.capture = [this](ValueTap::Values& values) {
+            if (auto* nbx = ptr.getRaw<t_fake_numbox>()) {
+                values = { static_cast<float>(nbx->x_outmode), static_cast<float>(nbx->x_rate), nbx->x_display, nbx->x_in_val };
+            }
+        };
+        pd->addSignalTap(&tap);
+
         startTimer(nextInterval);
         repaint();
 
@@ -66,14 +75,18 @@ public:
         objectParameters.addParamColourBG(&secondaryColour);
     }
 
-    void update() override
+    ~NumboxTildeObject() override
     {
-        input.setText(input.formatNumber(getValue()), dontSendNotification);
+        pd->removeSignalTap(&tap);
+    }
 
+    void update() override
+    {
         min = getMinimum();
         max = getMaximum();
 
         if (auto object = ptr.get<t_fake_numbox>()) {
+            input.setText(input.formatNumber(object->x_outmode ? object->x_display : object->x_in_val), dontSendNotification);
             interval = object->x_rate;
             ramp = object->x_ramp_ms;
             init = object->x_set_val;
@@ -273,17 +286,15 @@ public:
         startTimer(nextInterval);
     }
 
+    // Reads the values the audio thread copied for us, without locking
     float getValue()
     {
-        if (auto nbx = ptr.get<t_fake_numbox>()) {
-            mode = nbx->x_outmode;
-
-            nextInterval = nbx->x_rate;
-
-            return mode ? nbx->x_display : nbx->x_in_val;
+        if (tap.update()) {
+            mode = static_cast<int>(tap[0]);
+            nextInterval = std::max(static_cast<int>(tap[1]), 1);
         }
 
-        return 0.0f;
+        return mode ? tap[2] : tap[3];
     }
 
     float getMinimum()
@@ -9,6 +9,9 @@
 
 #include "Utility/Config.h"
 #include "Utility/Fonts.h"
+#include "Utility/MinMaxPyramid.h"
+#include "Utility/SignalTap.h"
+#include "Utility/ScopeTap.h"
 
 #include "ObjectBase.h"
 
@@ -87,6 +90,15 @@ public:
     void setPdBounds(Rectangle<int> newBounds) override {};
 };
 
+void ObjectLabel::paint(Graphics& g)
+{
+    // Labels are too small to read when the canvas is zoomed out far
+    if (auto* parentObject = dynamic_cast<Object*>(object); parentObject && parentObject->cnv->isLowDetail())
+        return;
+
+    Label::paint(g);
+}
+
 ObjectBase::ObjectSizeListener::ObjectSizeListener(Object* obj)
     : object(obj)
 {
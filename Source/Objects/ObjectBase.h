@@ -34,6 +34,8 @@ public:
         setInterceptsMouseClicks(false, false);
     }
 
+    void paint(Graphics& g) override;
+
 private:
     Component* object;
 };
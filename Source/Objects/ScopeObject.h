@@ -8,8 +8,8 @@ template<typename S>
 class ScopeBase : public ObjectBase
     , public Timer {
 
-    std::vector<float> x_buffer;
-    std::vector<float> y_buffer;
+    ScopeTap tap;
+    Path waveform;
 
     Value gridColour = SynchronousValue();
     Value triggerMode = SynchronousValue();
@@ -41,7 +41,19 @@ public:
         objectParameters.addParamReceiveSymbol(&receiveSymbol);
         objectParameters.addParamSendSymbol(&sendSymbol);
 
-        startTimerHz(25);
+        tap.capture = [this]() {
+            if (auto* scope = ptr.getRaw<S>()) {
+                tap.push(scope->x_xbuflast, scope->x_ybuflast, scope->x_bufsize, scope->x_xymode, scope->x_min, scope->x_max);
+            }
+        };
+        pd->addSignalTap(&tap);
+
+        startTimerHz(60);
+    }
+
+    ~ScopeBase()
+    {
+        pd->removeSignalTap(&tap);
     }
 
     void updateSizeProperty() override
@@ -113,6 +125,7 @@ public:
 
     void resized() override
     {
+        tap.setResolution(getWidth() - 2, getHeight() - 2);
     }
 
     void paint(Graphics& g) override
@@ -137,22 +150,8 @@ public:
             yy += dy;
         }
 
-        // skip drawing waveform if buffer is empty
-        if (!(y_buffer.empty() || x_buffer.empty())) {
-            Point<float> lastPoint = Point<float>(x_buffer[0], y_buffer[0]);
-            Point<float> newPoint;
-
-            g.setColour(Colour::fromString(primaryColour.toString()));
-
-            Path p;
-            for (size_t i = 1; i < y_buffer.size(); i++) {
-                newPoint = Point<float>(x_buffer[i], y_buffer[i]);
-                Line segment(lastPoint, newPoint);
-                p.addLineSegment(segment, 1.0f);
-                lastPoint = newPoint;
-            }
-            g.fillPath(p);
-        }
+        g.setColour(Colour::fromString(primaryColour.toString()));
+        g.fillPath(waveform);
 
         bool selected = object->isSelected() && !cnv->isGraph;
         auto outlineColour = object->findColour(selected ? PlugDataColour::objectSelectedOutlineColourId : objectOutlineColourId);
@@ -163,60 +162,58 @@ public:
 
     void timerCallback() override
     {
-        int bufsize, mode;
-        float min, max;
-
         if (object->iolets.size() == 3)
             object->iolets[2]->setVisible(false);
 
-        if (auto scope = ptr.get<S>()) {
-            bufsize = scope->x_bufsize;
-            min = scope->x_min;
-            max = scope->x_max;
-            mode = scope->x_xymode;
-
-            if (x_buffer.size() != bufsize) {
-                x_buffer.resize(bufsize);
-                y_buffer.resize(bufsize);
-            }
+        if (!tap.update())
+            return;
 
-            std::copy(scope->x_xbuflast, scope->x_xbuflast + bufsize, x_buffer.data());
-            std::copy(scope->x_ybuflast, scope->x_ybuflast + bufsize, y_buffer.data());
-        }
+        auto const& frame = tap.getFrame();
 
-        if (min > max) {
-            auto temp = max;
-            max = min;
-            min = temp;
-        }
+        auto min = frame.min;
+        auto max = frame.max;
+        if (min > max)
+            std::swap(min, max);
+
+        float const waveAreaWidth = getWidth() - 2;
+        float const waveAreaHeight = getHeight() - 2;
+
+        // The waveform only changes here, so paint doesn't need to rebuild it
+        waveform.clear();
+
+        if (frame.isEnvelope) {
+            // One line per pixel column, from the minimum to the maximum of the points under it
+            for (int i = 0; i < frame.size; i++) {
+                if (frame.mode == ScopeTap::Vertical) {
+                    auto const x1 = jmap<float>(frame.first[i], min, max, 2.f, waveAreaWidth);
+                    auto const x2 = jmap<float>(frame.second[i], min, max, 2.f, waveAreaWidth);
+                    waveform.addRectangle(std::min(x1, x2) - 0.5f, static_cast<float>(i), std::abs(x2 - x1) + 1.0f, 1.0f);
+                } else {
+                    auto const y1 = jmap<float>(frame.first[i], min, max, waveAreaHeight, 2.f);
+                    auto const y2 = jmap<float>(frame.second[i], min, max, waveAreaHeight, 2.f);
+                    waveform.addRectangle(static_cast<float>(i), std::min(y1, y2) - 0.5f, 1.0f, std::abs(y2 - y1) + 1.0f);
+                }
+            }
+        } else if (frame.size > 1) {
+            auto getPoint = [&](int n) -> Point<float> {
+                switch (frame.mode) {
+                case ScopeTap::Horizontal:
+                    return { n * waveAreaWidth / frame.size, jmap<float>(frame.first[n], min, max, waveAreaHeight, 2.f) };
+                case ScopeTap::Vertical:
+                    return { jmap<float>(frame.first[n], min, max, 2.f, waveAreaWidth), n * waveAreaHeight / frame.size };
+                default:
+                    return { jmap<float>(frame.first[n], min, max, 2.f, waveAreaWidth), jmap<float>(frame.second[n], min, max, waveAreaHeight, 2.f) };
+                }
+            };
 
-        float oldx = 0, oldy = 0;
-        float dx = (getWidth() - 2) / (float)bufsize;
-        float dy = (getHeight() - 2) / (float)bufsize;
-
-        float waveAreaHeight = getHeight() - 2;
-        float waveAreaWidth = getWidth() - 2;
-
-        for (int n = 0; n < bufsize; n++) {
-            switch (mode) {
-            case 1:
-                y_buffer[n] = jmap<float>(x_buffer[n], min, max, waveAreaHeight, 2.f);
-                x_buffer[n] = oldx;
-                oldx += dx;
-                break;
-            case 2:
-                x_buffer[n] = jmap<float>(y_buffer[n], min, max, 2.f, waveAreaWidth);
-                y_buffer[n] = oldy;
-                oldy += dy;
-                break;
-            case 3:
-                x_buffer[n] = jmap<float>(x_buffer[n], min, max, 2.f, waveAreaWidth);
-                y_buffer[n] = jmap<float>(y_buffer[n], min, max, waveAreaHeight, 2.f);
-                break;
-            default:
-                break;
+            auto lastPoint = getPoint(0);
+            for (int n = 1; n < frame.size; n++) {
+                auto const newPoint = getPoint(n);
+                waveform.addLineSegment({ lastPoint, newPoint }, 1.0f);
+                lastPoint = newPoint;
             }
         }
+
         repaint();
     }
 
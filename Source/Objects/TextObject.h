@@ -134,8 +134,9 @@ struct TextObjectHelper {
         auto lines = StringArray::fromLines(text);
         int w = minWidth;
 
+        auto font = Font(fontHeight);
         for (auto& line : lines) {
-            w = std::max<int>(Font(fontHeight).getStringWidthFloat(line) + 14.0f, w);
+            w = std::max<int>(Fonts::getGlyphCache().getStringWidth(font, line) + 14.0f, w);
         }
 
         return w;
@@ -4,11 +4,18 @@
  // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
  */
 
-class VUMeterObject final : public ObjectBase {
+class VUMeterObject final : public ObjectBase
+    , public Timer {
 
     IEMHelper iemHelper;
     Value sizeProperty = SynchronousValue();
 
+    // Peak and RMS level in dB, silent until the audio thread copied them
+    ValueTap tap = ValueTap({ -101.0f, -101.0f });
+
+    // Peak and RMS level that were drawn last
+    std::array<float, 2> levels = { -101.0f, -101.0f };
+
 public:
     VUMeterObject(void* ptr, Object* object)
         : ObjectBase(ptr, object)
@@ -24,6 +31,22 @@ public:
         objectParameters.addParamReceiveSymbol(&iemHelper.receiveSymbol);
         objectParameters.addParamSendSymbol(&iemHelper.sendSymbol, "nosndno");
         iemHelper.addIemParameters(objectParameters, false, false, -1);
+
+        tap.capture = [this](ValueTap::Values& values) {
+            if (auto* vu = ptr.getRaw<t_vu>()) {
+                values[0] = vu->x_fp;
+                values[1] = vu->x_fr;
+            }
+        };
+        pd->addSignalTap(&tap);
+
+        // The levels can change without a message we're listening to, so keep checking if the audio thread copied new ones
+        startTimerHz(30);
+    }
+
+    ~VUMeterObject() override
+    {
+        pd->removeSignalTap(&tap);
     }
 
     void updateSizeProperty() override
@@ -90,9 +113,18 @@ public:
         iemHelper.setPdBounds(b);
     }
 
+    void timerCallback() override
+    {
+        // The tap is copied while audio is running, even if the levels didn't change
+        if (tap.update() && (tap[0] != levels[0] || tap[1] != levels[1])) {
+            levels = { tap[0], tap[1] };
+            repaint();
+        }
+    }
+
     void paint(Graphics& g) override
     {
-        auto values = std::vector<float> { ptr.getRaw<t_vu>()->x_fp, ptr.getRaw<t_vu>()->x_fr };
+        auto const& values = levels;
 
         int height = getHeight();
         int width = getWidth();
@@ -169,6 +201,10 @@ public:
     {
         switch (hash(symbol)) {
         case hash("float"): {
+            // A vu can be fed by control messages while audio is off, then the tap isn't updated
+            if (auto vu = ptr.get<t_vu>()) {
+                levels = { vu->x_fp, vu->x_fr };
+            }
             repaint();
             break;
         }
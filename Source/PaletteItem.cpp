@@ -52,7 +52,18 @@ PaletteItem::PaletteItem(PluginEditor* e, PaletteDraggableList* parent, ValueTre
     addChildComponent(deleteButton);
 
     isSubpatch = isSubpatchOrAbstraction(palettePatch);
-    if (isSubpatch) {
+    if (isSubpatch && StringArray::fromLines(palettePatch).size() == 1) {
+        // Single objects need to be created in pd to count their iolets, do that once the palette is built
+        // The item is drawn without iolets until the result comes in
+        editor->offlineRenderer.countIoletsAsync(palettePatch, [_this = SafePointer(this)](OfflineObjectRenderer::Iolets const& iolets) {
+            if (!_this)
+                return;
+
+            _this->inlets = iolets.first;
+            _this->outlets = iolets.second;
+            _this->repaint();
+        });
+    } else if (isSubpatch) {
         auto iolets = countIolets(palettePatch);
         inlets = iolets.first;
         outlets = iolets.second;
@@ -230,6 +241,14 @@ void PaletteItem::mouseEnter(MouseEvent const& e)
 {
     reorderButton->setVisible(true);
     deleteButton.setVisible(true);
+
+    // Start rendering the drag image in the background, so it's likely ready when the user starts dragging
+    if (dragImage.image.isNull()) {
+        dragImage = editor->offlineRenderer.getPreviewAsync(palettePatch, 2.0f, [_this = SafePointer(this)](ImageWithOffset const& preview) {
+            if (_this)
+                _this->dragImage = preview;
+        });
+    }
 }
 
 void PaletteItem::mouseExit(MouseEvent const& e)
@@ -254,9 +273,9 @@ void PaletteItem::mouseDrag(MouseEvent const& e)
     auto dragContainer = ZoomableDragAndDropContainer::findParentDragContainerFor(this);
 
     auto scale = 2.0f;
+    // If the background render didn't finish yet, render it now
     if (dragImage.image.isNull()) {
-        auto offlineObjectRenderer = editor->offlineRenderer;
-        dragImage = offlineObjectRenderer.patchToTempImage(palettePatch, scale);
+        dragImage = editor->offlineRenderer.patchToTempImage(palettePatch, scale);
     }
 
     if (auto* overReorderButton = dynamic_cast<ReorderButton*>(e.originalComponent)) {
@@ -350,8 +369,7 @@ std::pair<std::vector<bool>, std::vector<bool>> PaletteItem::countIolets(String
 
     // In case the patch contains a single object, we need to use a different method to find the number and kind inlets and outlets
     if (lines.size() == 1) {
-        auto offlineObjectRenderer = editor->offlineRenderer;
-        return offlineObjectRenderer.countIolets(lines[0]);
+        return editor->offlineRenderer.countIolets(lines[0]);
     }
 
     for (auto& line : lines) {
@@ -0,0 +1,159 @@
+/*
+ // Copyright (c) 2015-2023 Pierre Guillot and Timothy Schoen.
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+
+#include "Clipboard.h"
+
+namespace pd {
+
+Clipboard::~Clipboard()
+{
+    clear();
+}
+
+void Clipboard::clear()
+{
+    if (binbuf) {
+        binbuf_free(binbuf);
+        binbuf = nullptr;
+    }
+
+    instance = nullptr;
+    text = String();
+    positions.clear();
+    bounds = Rectangle<int>();
+    numConnections = 0;
+}
+
+void Clipboard::setContent(Instance* newInstance, t_binbuf* newBinbuf, String const& newText)
+{
+    clear();
+
+    instance = newInstance;
+    binbuf = newBinbuf;
+    text = newText;
+
+    updateIndex();
+}
+
+void Clipboard::setContent(Instance* newInstance, String const& newText)
+{
+    auto* newBinbuf = binbuf_new();
+    auto utf8 = newText.toUTF8();
+    binbuf_text(newBinbuf, utf8.getAddress(), utf8.sizeInBytes() - 1);
+
+    setContent(newInstance, newBinbuf, newText);
+}
+
+bool Clipboard::matches(Instance* otherInstance, String const& otherText) const
+{
+    return binbuf && instance == otherInstance && text == otherText;
+}
+
+bool Clipboard::isEmpty() const
+{
+    return !binbuf || binbuf_getnatom(binbuf) == 0;
+}
+
+void Clipboard::updateIndex()
+{
+    if (!binbuf)
+        return;
+
+    auto const numAtoms = binbuf_getnatom(binbuf);
+    auto* atoms = binbuf_getvec(binbuf);
+
+    auto isSymbol = [atoms, numAtoms](int idx, char const* name) {
+        return idx < numAtoms && atoms[idx].a_type == A_SYMBOL && !strcmp(atoms[idx].a_w.w_symbol->s_name, name);
+    };
+
+    auto isFloat = [atoms, numAtoms](int idx) {
+        return idx < numAtoms && atoms[idx].a_type == A_FLOAT;
+    };
+
+    int canvasDepth = 0;
+    int minX = std::numeric_limits<int>::max();
+    int minY = std::numeric_limits<int>::max();
+    int maxX = std::numeric_limits<int>::min();
+    int maxY = std::numeric_limits<int>::min();
+
+    auto addPosition = [&](int idx) {
+        auto x = static_cast<int>(atoms[idx].a_w.w_float);
+        auto y = static_cast<int>(atoms[idx + 1].a_w.w_float);
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+        positions.push_back(idx);
+    };
+
+    // Walk over all messages in the binbuf, each message ends with a semicolon
+    int start = 0;
+    while (start < numAtoms) {
+        int end = start;
+        while (end < numAtoms && atoms[end].a_type != A_SEMI)
+            end++;
+
+        if (isSymbol(start, "#N") && isSymbol(start + 1, "canvas")) {
+            canvasDepth++;
+        } else if (isSymbol(start, "#X") && isSymbol(start + 1, "restore")) {
+            // The position of a subpatch is stored at the end of its content
+            if (canvasDepth == 1 && isFloat(start + 2) && isFloat(start + 3)) {
+                addPosition(start + 2);
+            }
+            canvasDepth--;
+        } else if (canvasDepth == 0 && isSymbol(start, "#X")) {
+            if (isSymbol(start + 1, "connect")) {
+                numConnections++;
+            } else if (!isSymbol(start + 1, "f") && isFloat(start + 2) && isFloat(start + 3)) {
+                addPosition(start + 2);
+            }
+        }
+
+        start = end + 1;
+    }
+
+    if (!positions.empty()) {
+        bounds = Rectangle<int>::leftTopRightBottom(minX, minY, maxX, maxY);
+    }
+}
+
+void Clipboard::translateTo(Point<int> position)
+{
+    if (!binbuf || positions.empty())
+        return;
+
+    auto const offset = position - bounds.getPosition();
+    auto* atoms = binbuf_getvec(binbuf);
+
+    for (auto idx : positions) {
+        atoms[idx].a_w.w_float += offset.x;
+        atoms[idx + 1].a_w.w_float += offset.y;
+    }
+
+    bounds.translate(offset.x, offset.y);
+}
+
+Rectangle<int> Clipboard::getBounds() const
+{
+    return bounds;
+}
+
+int Clipboard::getNumObjects() const
+{
+    return static_cast<int>(positions.size());
+}
+
+int Clipboard::getNumConnections() const
+{
+    return numConnections;
+}
+
+t_binbuf* Clipboard::getBinbuf() const
+{
+    return binbuf;
+}
+
+} // namespace pd
@@ -0,0 +1,66 @@
+/*
+ // Copyright (c) 2015-2023 Pierre Guillot and Timothy Schoen.
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <m_pd.h>
+
+namespace pd {
+
+class Instance;
+
+// Structured copy of a selection of objects and connections
+// It keeps the Pd atoms around, together with the positions of all top-level objects,
+// so we can move the selection and paste it without converting it to text and back
+// Atoms can only be used inside the Pd instance that created them
+class Clipboard {
+public:
+    Clipboard() = default;
+    ~Clipboard();
+
+    // Takes ownership of the binbuf
+    void setContent(Instance* instance, t_binbuf* binbuf, String const& text = String());
+
+    // Parses text in the Pd file format, should be called on the Pd instance
+    void setContent(Instance* instance, String const& text);
+
+    // Checks if this clipboard was created from this text, by this instance
+    bool matches(Instance* instance, String const& text) const;
+
+    bool isEmpty() const;
+
+    // Moves the selection, so that its top-left object ends up at position
+    void translateTo(Point<int> position);
+
+    // Bounds of the positions of all top-level objects
+    Rectangle<int> getBounds() const;
+
+    int getNumObjects() const;
+    int getNumConnections() const;
+
+    t_binbuf* getBinbuf() const;
+
+private:
+    void clear();
+    void updateIndex();
+
+    Instance* instance = nullptr;
+    t_binbuf* binbuf = nullptr;
+
+    // Text that was put on the system clipboard, used to find out if the system clipboard has changed since
+    String text;
+
+    // Atom index of the x position of each top-level object, the y position is always the next atom
+    std::vector<int> positions;
+
+    Rectangle<int> bounds;
+    int numConnections = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(Clipboard)
+};
+
+} // namespace pd
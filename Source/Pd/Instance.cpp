@@ -814,6 +814,47 @@ void Instance::unlockAudioThread()
     audioLock.exit();
 }
 
+void Instance::startDSPRebuild()
+{
+    // The lock is recursive, so nested edits take it again, and only the outermost one rebuilds the graph
+    lockAudioThread();
+
+    if (dspRebuildDepth++ > 0)
+        return;
+
+    setThis();
+
+    // With DSP suspended, Pd's internal calls to canvas_update_dsp won't rebuild the graph for every change
+    // When DSP is off, this does nothing and there is nothing to rebuild afterwards
+    dspStateBeforeRebuild = canvas_suspend_dsp();
+}
+
+void Instance::finishDSPRebuild()
+{
+    jassert(dspRebuildDepth > 0);
+
+    double rebuildTime = 0.0;
+
+    if (--dspRebuildDepth == 0 && dspStateBeforeRebuild) {
+        setThis();
+
+        // Only while the graph is being built, the audio thread skips blocks instead of waiting for us
+        auto const startTime = Time::getMillisecondCounterHiRes();
+        isRebuildingDSP = true;
+        canvas_resume_dsp(dspStateBeforeRebuild);
+        isRebuildingDSP = false;
+        rebuildTime = Time::getMillisecondCounterHiRes() - startTime;
+    }
+
+    unlockAudioThread();
+
+    // Report rebuilds that took longer than a single DSP tick, since those are the ones that made the audio thread skip blocks
+    auto const sampleRate = sys_getsr();
+    if (sampleRate > 0 && rebuildTime > (1000.0 * getBlockSize()) / sampleRate) {
+        logMessage("DSP graph rebuilt in " + String(rebuildTime, 2) + " ms");
+    }
+}
+
 void Instance::updateObjectImplementations()
 {
     objectImplementations->updateObjectImplementations();
@@ -15,6 +15,7 @@ extern "C" {
 
 #include "Utility/StringUtils.h"
 #include "Patch.h"
+#include "Clipboard.h"
 #include "Ofelia.h"
 
 class ObjectImplementationManager;
@@ -254,6 +255,9 @@ public:
 
     virtual void titleChanged() {};
 
+    // Called after Patch::commitTransaction, to update the GUI of that patch in one go
+    virtual void patchTransactionCommitted(Patch* patch) {};
+
     void enqueueFunctionAsync(std::function<void(void)> const& fn);
 
     void sendDirectMessage(void* object, String const& msg, std::vector<Atom>&& list);
@@ -303,6 +307,29 @@ public:
     bool tryLockAudioThread();
     void unlockAudioThread();
 
+    // Groups all DSP graph updates caused by a bulk edit into a single rebuild
+    // Only used for edits that can touch many objects at once, single edits are left to Pd, which only rebuilds when the graph changes
+    // While the graph is being rebuilt, the audio thread won't wait for the lock, see isRebuildingDSP
+    void startDSPRebuild();
+    void finishDSPRebuild();
+
+    struct ScopedDSPRebuild {
+        explicit ScopedDSPRebuild(Instance* instance)
+            : instance(instance)
+        {
+            instance->startDSPRebuild();
+        }
+
+        ~ScopedDSPRebuild()
+        {
+            instance->finishDSPRebuild();
+        }
+
+        Instance* instance;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedDSPRebuild)
+    };
+
     bool loadLibrary(String const& library);
 
     void* m_instance = nullptr;
@@ -325,6 +352,11 @@ public:
     bool isPerformingGlobalSync = false;
     CriticalSection const audioLock;
 
+    std::atomic<bool> isRebuildingDSP = false;
+
+    // Last selection that was copied from any patch in this instance
+    Clipboard clipboard;
+
 private:
     std::mutex weakReferenceMutex;
     std::unordered_map<void*, std::vector<pd_weak_reference*>> pdWeakReferences;
@@ -340,6 +372,10 @@ private:
     std::unique_ptr<FileChooser> openChooser;
     std::atomic<bool> consoleMute;
 
+    // Only changed while holding audioLock
+    int dspRebuildDepth = 0;
+    int dspStateBeforeRebuild = 0;
+
 protected:
     struct internal;
 
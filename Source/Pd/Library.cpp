@@ -10,9 +10,8 @@
 
 #include "Utility/Config.h"
 
-#include <BinaryData.h>
-
 #include "Utility/OSUtils.h"
+#include "Utility/SettingsFile.h"
 
 extern "C" {
 #include <m_pd.h>
@@ -39,8 +38,14 @@ namespace pd {
 
 void Library::updateLibrary()
 {
-    auto settingsTree = ValueTree::fromXml(ProjectInfo::appDataDir.getChildFile(".settings").loadFileAsString());
-    auto pathTree = settingsTree.getChildWithName("Paths");
+    // The settings file was already reloaded if it changed on disk
+    StringArray searchPaths;
+    for (auto path : SettingsFile::getInstance()->getPathsTree()) {
+        searchPaths.add(File(path.getProperty("Path").toString()).getFullPathName());
+    }
+
+    // Only reading the object names from pd needs the lock, scanning the search paths is done without it
+    StringArray pdObjects;
 
     sys_lock();
 
@@ -50,8 +55,6 @@ void Library::updateLibrary()
     auto* mlist = static_cast<t_methodentry*>(libpd_get_class_methods(o));
     t_methodentry* m;
 
-    allObjects.clear();
-
     int i;
     for (i = o->c_nmethod, m = mlist; i--; m++) {
         if (!m || !m->me_name)
@@ -59,49 +62,134 @@ void Library::updateLibrary()
 
         auto newName = String::fromUTF8(m->me_name->s_name);
         if (!(newName.startsWith("else/") || newName.startsWith("cyclone/") || newName.endsWith("_aliased"))) {
-            allObjects.add(newName);
+            pdObjects.add(newName);
         }
     }
 
-    // Find patches in our search tree
-    for (auto path : pathTree) {
-        auto filePath = path.getProperty("Path").toString();
+    sys_unlock();
 
-        auto file = File(filePath);
-        if (!file.exists() || !file.isDirectory())
-            continue;
+    objectSearchThread.addJob([this, pdObjects, searchPaths]() {
+        auto newObjects = pdObjects;
 
-        for (auto const& file : OSUtils::iterateDirectory(file, false, true)) {
-            if (file.hasFileExtension("pd")) {
-                auto filename = file.getFileNameWithoutExtension();
-                if (!filename.startsWith("help-") || filename.endsWith("-help")) {
-                    allObjects.add(filename);
-                }
+        // Find patches in our search tree, only rescanning the directories that changed since the last scan
+        bool cacheChanged = false;
+        for (auto const& path : searchPaths) {
+            newObjects.addArray(getAbstractionsInSearchPath(File(path), cacheChanged));
+        }
+
+        // Forget directories that were removed from the search paths
+        for (auto it = searchPathCache.begin(); it != searchPathCache.end();) {
+            if (!searchPaths.contains(it->first)) {
+                it = searchPathCache.erase(it);
+                cacheChanged = true;
+            } else {
+                ++it;
+            }
+        }
+
+        if (cacheChanged)
+            saveSearchPathCache();
+
+        std::vector<String> newSortedObjects(newObjects.begin(), newObjects.end());
+        std::sort(newSortedObjects.begin(), newSortedObjects.end());
+        newSortedObjects.erase(std::unique(newSortedObjects.begin(), newSortedObjects.end()), newSortedObjects.end());
+
+        std::lock_guard<std::recursive_mutex> lock(libraryLock);
+        allObjects.swapWith(newObjects);
+        sortedObjects.swap(newSortedObjects);
+    });
+}
+
+StringArray Library::getAbstractionsInSearchPath(File const& directory, bool& cacheChanged)
+{
+    if (!directory.isDirectory())
+        return {};
+
+    // Adding, removing or renaming a file changes the modification time of the directory
+    auto const path = directory.getFullPathName();
+    auto const modified = directory.getLastModificationTime().toMilliseconds();
+
+    auto& entry = searchPathCache[path];
+    if (entry.modified == modified && modified != 0)
+        return entry.abstractions;
+
+    StringArray abstractions;
+    for (auto const& file : OSUtils::iterateDirectory(directory, false, true)) {
+        if (file.hasFileExtension("pd")) {
+            auto filename = file.getFileNameWithoutExtension();
+            if (!filename.startsWith("help-") || filename.endsWith("-help")) {
+                abstractions.add(filename);
             }
         }
     }
 
-    sys_unlock();
+    entry = { modified, abstractions };
+    cacheChanged = true;
+
+    return abstractions;
 }
 
-Library::Library(pd::Instance* instance)
+void Library::loadSearchPathCache()
 {
-    MemoryInputStream instream(BinaryData::Documentation_bin, BinaryData::Documentation_binSize, false);
-    documentationTree = ValueTree::readFromStream(instream);
+    auto cacheTree = ValueTree::fromXml(ProjectInfo::cacheDir.getChildFile("LibraryCache.xml").loadFileAsString());
 
-    for (auto object : documentationTree) {
-        auto categories = object.getChildWithName("categories");
-        if (!categories.isValid())
-            continue;
+    for (auto directory : cacheTree) {
+        SearchPathCacheEntry entry;
+        entry.modified = static_cast<int64>(directory.getProperty("Modified"));
+        for (auto abstraction : directory) {
+            entry.abstractions.add(abstraction.getProperty("Name").toString());
+        }
 
-        for (auto category : categories) {
-            allCategories.addIfNotAlreadyThere(category.getProperty("name").toString());
+        searchPathCache[directory.getProperty("Path").toString()] = entry;
+    }
+}
+
+void Library::saveSearchPathCache()
+{
+    ValueTree cacheTree("LibraryCache");
+
+    for (auto& [path, entry] : searchPathCache) {
+        ValueTree directory("Directory");
+        directory.setProperty("Path", path, nullptr);
+        directory.setProperty("Modified", entry.modified, nullptr);
+
+        for (auto const& name : entry.abstractions) {
+            ValueTree abstraction("Abstraction");
+            abstraction.setProperty("Name", name, nullptr);
+            directory.appendChild(abstraction, nullptr);
         }
+
+        cacheTree.appendChild(directory, nullptr);
     }
 
+    // Not in appDataDir, because writing there would make our own watcher rescan the library again
+    ProjectInfo::cacheDir.createDirectory();
+    ProjectInfo::cacheDir.getChildFile("LibraryCache.xml").replaceWithText(cacheTree.toXmlString());
+}
+
+Library::Library(pd::Instance* instance)
+{
+    // Build the search index, or get it from another instance that already built it
+    objectSearchThread.addJob([this]() {
+        auto index = documentation->getSearchIndex();
+
+        std::lock_guard<std::recursive_mutex> lock(libraryLock);
+        documentationIndex = index;
+    });
+
+    // The search thread is the only one that uses the cache, so we load it there too
+    objectSearchThread.addJob([this]() {
+        loadSearchPathCache();
+    });
+
     watcher.addFolder(ProjectInfo::appDataDir);
     watcher.addListener(this);
 
+    abstractionListener.onChange = [this]() {
+        abstractionCache.clear();
+    };
+    abstractionWatcher.addListener(&abstractionListener);
+
     // Paths to search
     // First, only search vanilla, then search all documentation
     // Lastly, check the deken folder
@@ -116,73 +204,148 @@ Library::Library(pd::Instance* instance)
     });
 }
 
-StringArray Library::autocomplete(String const& query, File const& patchDirectory) const
+// Checks if all characters of the query appear in the name, in the same order
+static bool isFuzzyMatch(String const& query, String const& name)
 {
-    StringArray result;
-    result.ensureStorageAllocated(20);
+    auto q = query.getCharPointer();
+    for (auto n = name.getCharPointer(); !q.isEmpty() && !n.isEmpty(); ++n) {
+        if (CharacterFunctions::toLowerCase(*q) == CharacterFunctions::toLowerCase(*n))
+            ++q;
+    }
+
+    return q.isEmpty();
+}
 
-    if (patchDirectory.isDirectory()) {
-        for (auto const& file : OSUtils::iterateDirectory(patchDirectory, false, true, 20)) {
+StringArray const& Library::getAbstractionsInDirectory(File const& directory)
+{
+    auto const path = directory.getFullPathName();
+    if (auto cached = abstractionCache.find(path); cached != abstractionCache.end())
+        return cached->second;
+
+    StringArray abstractions;
+    if (directory.isDirectory()) {
+        for (auto const& file : OSUtils::iterateDirectory(directory, false, true)) {
             auto filename = file.getFileNameWithoutExtension();
-            if (file.hasFileExtension("pd") && filename.startsWith(query) && !filename.startsWith("help-") && !filename.endsWith("-help")) {
-                result.add(filename);
+            if (file.hasFileExtension("pd") && !filename.startsWith("help-") && !filename.endsWith("-help")) {
+                abstractions.add(filename);
             }
         }
-    }
-
-    for (auto const& str : allObjects) {
-        if (result.size() >= 20)
-            break;
 
-        if (str.startsWith(query)) {
-            result.addIfNotAlreadyThere(str);
-        }
+        if (!abstractionWatcher.getWatchedFolders().contains(directory))
+            abstractionWatcher.addFolder(directory);
     }
 
-    return result;
+    return abstractionCache[path] = abstractions;
 }
 
-void Library::getExtraSuggestions(int currentNumSuggestions, String const& query, std::function<void(StringArray)> const& callback)
+StringArray Library::autocomplete(String const& query, File const& patchDirectory)
 {
+    constexpr int maxResults = 20;
 
-    int const maxSuggestions = 20;
-    if (currentNumSuggestions > maxSuggestions)
-        return;
+    std::lock_guard<std::recursive_mutex> lock(libraryLock);
 
-    objectSearchThread.addJob([this, callback, query]() mutable {
-        StringArray result;
-        StringArray matches;
+    // Lower tiers are shown first
+    enum MatchTier {
+        Exact,
+        Tilde,      // the signal version, for example osc~ when typing osc
+        Namespaced, // for example list.append when typing list
+        Prefix,
+        Fuzzy
+    };
 
-        for (const auto& object : getAllObjects()) {
-            auto info = getObjectInfo(object);
+    struct Match {
+        String name;
+        int tier;
+        int usage;
+        bool isLocal;
+    };
 
-            auto description = info.getProperty("description").toString();
+    std::vector<Match> matches;
 
-            auto iolets = info.getChildWithName("iolets");
-            auto arguments = info.getChildWithName("arguments");
+    auto addMatch = [&](String const& name, bool isLocal) {
+        int tier = Prefix;
+        if (name == query)
+            tier = Exact;
+        else if (name == query + "~")
+            tier = Tilde;
+        else if (name.startsWith(query + "."))
+            tier = Namespaced;
+        else if (!name.startsWith(query))
+            tier = Fuzzy;
 
-            if (description.contains(query) || object.contains(query)) {
-                matches.addIfNotAlreadyThere(object);
-            }
+        matches.push_back({ name, tier, usageCount[name], isLocal });
+    };
 
-            for (auto arg : arguments) {
-                auto argDescription = arg.getProperty("description").toString();
-                if (argDescription.contains(query)) {
-                    matches.addIfNotAlreadyThere(object);
-                }
-            }
+    // Abstractions next to the patch
+    auto const& localAbstractions = getAbstractionsInDirectory(patchDirectory);
+    for (auto const& name : localAbstractions) {
+        if (name.startsWith(query)) {
+            addMatch(name, true);
+        }
+    }
 
-            for (auto iolet : iolets) {
-                auto ioletDescription = iolet.getProperty("description").toString();
-                if (description.contains(query)) {
-                    matches.addIfNotAlreadyThere(object);
-                }
+    // All names starting with the query are next to each other in the sorted list
+    for (auto it = std::lower_bound(sortedObjects.begin(), sortedObjects.end(), query); it != sortedObjects.end() && it->startsWith(query); ++it) {
+        if (!localAbstractions.contains(*it))
+            addMatch(*it, false);
+    }
+
+    // Only look for names that contain the letters of the query if there aren't enough names that start with it
+    if (matches.size() < maxResults && query.length() > 1) {
+        constexpr int maxFuzzyMatches = 200;
+        int numFuzzyMatches = 0;
+        for (auto const& name : sortedObjects) {
+            if (numFuzzyMatches >= maxFuzzyMatches)
+                break;
+
+            if (!name.startsWith(query) && isFuzzyMatch(query, name) && !localAbstractions.contains(name)) {
+                addMatch(name, false);
+                numFuzzyMatches++;
             }
         }
+    }
 
-        matches.sort(true);
-        result.addArray(matches);
-        matches.clear();
+    std::sort(matches.begin(), matches.end(), [](Match const& a, Match const& b) {
+        if (a.tier != b.tier)
+            return a.tier < b.tier;
+        if (a.usage != b.usage)
+            return a.usage > b.usage;
+        if (a.isLocal != b.isLocal)
+            return a.isLocal;
+        if (a.name.length() != b.name.length())
+            return a.name.length() < b.name.length();
+
+        return a.name.compareNatural(b.name) < 0;
+    });
+
+    StringArray result;
+    for (int i = 0; i < std::min<int>(maxResults, matches.size()); i++) {
+        result.add(matches[i].name);
+    }
+
+    return result;
+}
+
+void Library::recordUsage(String const& name)
+{
+    std::lock_guard<std::recursive_mutex> lock(libraryLock);
+
+    // Don't count typos
+    if (std::binary_search(sortedObjects.begin(), sortedObjects.end(), name)) {
+        usageCount.set(name, usageCount[name] + 1);
+    }
+}
+
+void Library::getExtraSuggestions(int currentNumSuggestions, String const& query, std::function<void(StringArray)> const& callback)
+{
+
+    int const maxSuggestions = 20;
+    if (currentNumSuggestions > maxSuggestions)
+        return;
+
+    // The search thread builds the documentation index first, so it is always ready here
+    objectSearchThread.addJob([this, callback, query, maxSuggestions]() mutable {
+        auto result = searchDocumentation(query, maxSuggestions);
 
         MessageManager::callAsync([callback, result]() {
             callback(result);
@@ -190,9 +353,23 @@ void Library::getExtraSuggestions(int currentNumSuggestions, String const& query
     });
 }
 
+StringArray Library::searchDocumentation(String const& query, int maxResults)
+{
+    std::shared_ptr<DocumentationIndex const> index;
+    {
+        std::lock_guard<std::recursive_mutex> lock(libraryLock);
+        index = documentationIndex;
+    }
+
+    if (!index)
+        return {};
+
+    return index->search(query, maxResults);
+}
+
 ValueTree Library::getObjectInfo(String const& name)
 {
-    return documentationTree.getChildWithProperty("name", name);
+    return documentation->getObjectInfo(name);
 }
 
 std::array<StringArray, 2> Library::parseIoletTooltips(ValueTree const& iolets, String const& name, int numIn, int numOut)
@@ -250,12 +427,13 @@ std::array<StringArray, 2> Library::parseIoletTooltips(ValueTree const& iolets,
 
 StringArray Library::getAllObjects()
 {
+    std::lock_guard<std::recursive_mutex> lock(libraryLock);
     return allObjects;
 }
 
 StringArray Library::getAllCategories()
 {
-    return allCategories;
+    return documentation->getAllCategories();
 }
 
 void Library::fsChangeCallback()
@@ -9,6 +9,7 @@
 #include <m_pd.h>
 #include "../Utility/FileSystemWatcher.h"
 #include "../Utility/Config.h"
+#include "../Utility/DocumentationDatabase.h"
 
 namespace pd {
 
@@ -26,9 +27,18 @@ public:
 
     void updateLibrary();
 
-    StringArray autocomplete(String const& query, File const& patchDirectory) const;
+    // Object names and abstractions matching the query, best matches first
+    StringArray autocomplete(String const& query, File const& patchDirectory);
+
+    // Objects that were created more often rank higher in the suggestions
+    void recordUsage(String const& name);
+
     void getExtraSuggestions(int currentNumSuggestions, String const& query, std::function<void(StringArray)> const& callback);
 
+    // Objects whose documentation contains all words of the query, best matches first
+    // Returns nothing until the index has been built in the background
+    StringArray searchDocumentation(String const& query, int maxResults = -1);
+
     static std::array<StringArray, 2> parseIoletTooltips(ValueTree const& iolets, String const& name, int numIn, int numOut);
 
     void fsChangeCallback() override;
@@ -57,15 +67,49 @@ public:
     static inline StringArray objectOrigins = { "vanilla", "ELSE", "cyclone", "heavylib", "pdlua" };
 
 private:
+    // Abstractions in a search path, only scanned again if the directory changed since the last scan
+    // Only used by the search thread
+    StringArray getAbstractionsInSearchPath(File const& directory, bool& cacheChanged);
+
+    // The search path scans are stored in ProjectInfo::cacheDir/LibraryCache.xml, so we don't have to scan all libraries on startup
+    void loadSearchPathCache();
+    void saveSearchPathCache();
+
+    // Abstractions in a patch directory, cached until something in one of the cached directories changes
+    StringArray const& getAbstractionsInDirectory(File const& directory);
+
+    struct DirectoryListener : public FileSystemWatcher::Listener {
+        std::function<void()> onChange;
+        void fsChangeCallback() override { onChange(); }
+    };
+
+    struct SearchPathCacheEntry {
+        int64 modified = 0;
+        StringArray abstractions;
+    };
+
+    // The search thread updates allObjects and sortedObjects, so only use them while holding libraryLock
     StringArray allObjects;
-    StringArray allCategories;
+
+    // All object names without duplicates, sorted so we can find all names with a prefix with a binary search
+    std::vector<String> sortedObjects;
+
+    std::map<String, SearchPathCacheEntry> searchPathCache;
+
+    std::map<String, StringArray> abstractionCache;
+    FileSystemWatcher abstractionWatcher;
+    DirectoryListener abstractionListener;
+
+    HashMap<String, int> usageCount;
 
     std::recursive_mutex libraryLock;
 
     FileSystemWatcher watcher;
     ThreadPool objectSearchThread = ThreadPool(1);
 
-    ValueTree documentationTree;
+    // Shared by all instances, and only decoded as far as needed
+    SharedResourcePointer<DocumentationDatabase> documentation;
+    std::shared_ptr<DocumentationIndex const> documentationIndex;
 };
 
 } // namespace pd
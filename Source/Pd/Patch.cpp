@@ -245,7 +245,6 @@ void* Patch::createGraph(int x, int y, String const& name, int size, int drawMod
 
 void* Patch::createObject(int x, int y, String const& name)
 {
-
     instance->setThis();
 
     StringArray tokens;
@@ -389,119 +388,47 @@ void* Patch::renameObject(void* obj, String const& name)
 void Patch::copy()
 {
     if (auto patch = ptr.get<t_glist>()) {
+        auto* binbuf = libpd_copybinbuf(patch.get());
+
+        // The text is only used for the system clipboard, pasting inside plugdata will use the binbuf
+        char* text;
         int size;
-        char const* text = libpd_copy(patch.get(), &size);
+        binbuf_gettext(binbuf, &text, &size);
         auto copied = String::fromUTF8(text, size);
+        freebytes(static_cast<void*>(text), static_cast<size_t>(size) * sizeof(char));
+
+        instance->clipboard.setContent(instance, binbuf, copied);
+
         MessageManager::callAsync([copied]() mutable { SystemClipboard::copyTextToClipboard(copied); });
     }
 }
 
-String Patch::translatePatchAsString(String const& patchAsString, Point<int> position)
+void Patch::paste(Point<int> position)
 {
-    int minX = std::numeric_limits<int>::max();
-    int minY = std::numeric_limits<int>::max();
-
-    int canvasDepth = 0;
-
-    auto isObject = [](StringArray& tokens) {
-        return tokens[0] == "#X" && tokens[1] != "connect" && tokens[1] != "f" && tokens[2].containsOnly("-0123456789") && tokens[3].containsOnly("-0123456789");
-    };
-
-    // blank message objects have a comma after their position: "#X msg 0 0, f 9;"
-    // this normally isn't an issue, but because they are blank, the comma is next to the number token and doesn't get parsed correctly
-    auto isMsg = [](StringArray& tokens) {
-        return tokens[0] == "#X" && tokens[1] == "msg";
-    };
-
-    auto isStartingCanvas = [](StringArray& tokens) {
-        return tokens[0] == "#N" && tokens[1] == "canvas" && tokens[2].containsOnly("-0123456789") && tokens[3].containsOnly("-0123456789") && tokens[4].containsOnly("-0123456789") && tokens[5].containsOnly("-0123456789");
-    };
-
-    auto isEndingCanvas = [](StringArray& tokens) {
-        return tokens[0] == "#X" && tokens[1] == "restore" && tokens[2].containsOnly("-0123456789") && tokens[3].containsOnly("-0123456789");
-    };
-
-    for (auto& line : StringArray::fromLines(patchAsString)) {
-
-        line = line.upToLastOccurrenceOf(";", false, false);
-
-        auto tokens = StringArray::fromTokens(line, true);
-
-        if (isStartingCanvas(tokens)) {
-            canvasDepth++;
-        }
+    Instance::ScopedDSPRebuild dspRebuild(instance);
 
-        if (canvasDepth == 0) {
-            if (isObject(tokens)) {
-                minX = std::min(minX, tokens[2].getIntValue());
-                minY = std::min(minY, tokens[3].getIntValue());
-            } else if (isMsg(tokens)) {
-                minX = std::min(minX, tokens[2].getIntValue());
-                minY = std::min(minY, tokens[3].removeCharacters(",").getIntValue());
-            }
-        }
-
-        if (isEndingCanvas(tokens)) {
-            if (canvasDepth == 1) {
-                minX = std::min(minX, tokens[2].getIntValue());
-                minY = std::min(minY, tokens[3].getIntValue());
-            }
-            canvasDepth--;
-        }
-    }
-
-    canvasDepth = 0;
-    auto toPaste = StringArray::fromLines(patchAsString);
-    for (auto& line : toPaste) {
-        line = line.upToLastOccurrenceOf(";", false, false);
-        auto tokens = StringArray::fromTokens(line, true);
-        if (isStartingCanvas(tokens)) {
-            canvasDepth++;
-        }
-
-        if (canvasDepth == 0) {
-            if (isObject(tokens)) {
-                tokens.set(2, String(tokens[2].getIntValue() - minX + position.x));
-                tokens.set(3, String(tokens[3].getIntValue() - minY + position.y));
-                line = tokens.joinIntoString(" ");
-            } else if (isMsg(tokens)) {
-                tokens.set(2, String(tokens[2].getIntValue() - minX + position.x));
-                tokens.set(3, String(tokens[3].removeCharacters(",").getIntValue() - minY + position.y) + ",");
-                line = tokens.joinIntoString(" ");
-            }
-        }
-
-        if (isEndingCanvas(tokens)) {
-            if (canvasDepth == 1) {
-                tokens.set(2, String(tokens[2].getIntValue() - minX + position.x));
-                tokens.set(3, String(tokens[3].getIntValue() - minY + position.y));
-            }
+    auto text = SystemClipboard::getTextFromClipboard();
 
-            line = tokens.joinIntoString(" ");
+    if (auto patch = ptr.get<t_glist>()) {
+        setCurrent();
 
-            canvasDepth--;
+        // Only parse the system clipboard if something else than plugdata put it there
+        auto& clipboard = instance->clipboard;
+        if (!clipboard.matches(instance, text)) {
+            clipboard.setContent(instance, text);
         }
 
-        line += ";";
-    }
-
-    return toPaste.joinIntoString("\n");
-}
-
-void Patch::paste(Point<int> position)
-{
-    auto text = SystemClipboard::getTextFromClipboard();
+        // for some reason when we paste into PD, we need to apply a translation?
+        clipboard.translateTo(position.translated(1540, 1540));
 
-    // for some reason when we paste into PD, we need to apply a translation?
-    auto translatedObjects = translatePatchAsString(text, position.translated(1540, 1540));
-
-    if (auto patch = ptr.get<t_glist>()) {
-        libpd_paste(patch.get(), translatedObjects.toRawUTF8());
+        libpd_pastebinbuf(patch.get(), clipboard.getBinbuf());
     }
 }
 
 void Patch::duplicate()
 {
+    Instance::ScopedDSPRebuild dspRebuild(instance);
+
     if (auto patch = ptr.get<t_glist>()) {
         setCurrent();
         libpd_duplicate(patch.get());
@@ -529,7 +456,7 @@ void Patch::deselectAll()
 
 void Patch::removeObject(void* obj)
 {
-    instance->lockAudioThread();
+    ScopedLock audioLock(instance->audioLock);
 
     if (auto patch = ptr.get<t_glist>()) {
         setCurrent();
@@ -630,6 +557,8 @@ void Patch::finishRemove()
 
 void Patch::removeSelection()
 {
+    Instance::ScopedDSPRebuild dspRebuild(instance);
+
     if (auto patch = ptr.get<t_glist>()) {
         setCurrent();
         libpd_removeselection(patch.get());
@@ -650,8 +579,41 @@ void Patch::endUndoSequence(String const& name)
     }
 }
 
+void Patch::startTransaction(String const& name)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    // Nested transactions get merged into the outer one
+    if (transactionDepth++ > 0)
+        return;
+
+    transactionName = name;
+
+    // Takes the Pd lock and suspends DSP, until the transaction is committed
+    instance->startDSPRebuild();
+
+    setCurrent();
+    startUndoSequence(transactionName);
+}
+
+void Patch::commitTransaction()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    jassert(transactionDepth > 0);
+
+    if (--transactionDepth > 0)
+        return;
+
+    endUndoSequence(transactionName);
+
+    instance->finishDSPRebuild();
+    instance->patchTransactionCommitted(this);
+}
+
 void Patch::undo()
 {
+    Instance::ScopedDSPRebuild dspRebuild(instance);
+
     if (auto patch = ptr.get<t_glist>()) {
         setCurrent();
         glist_noselect(patch.get());
@@ -663,6 +625,8 @@ void Patch::undo()
 
 void Patch::redo()
 {
+    Instance::ScopedDSPRebuild dspRebuild(instance);
+
     if (auto patch = ptr.get<t_glist>()) {
         setCurrent();
         glist_noselect(patch.get());
@@ -760,8 +724,6 @@ String Patch::getCanvasContent()
 
     freebytes(static_cast<void*>(buf), static_cast<size_t>(bufsize) * sizeof(char));
 
-    instance->unlockAudioThread();
-
     return content;
 }
 
@@ -60,8 +60,6 @@ public:
 
     void setVisible(bool shouldVis);
 
-    static String translatePatchAsString(String const& clipboardContent, Point<int> position);
-
     t_glist* getRoot();
 
     void copy();
@@ -71,6 +69,13 @@ public:
     void startUndoSequence(String const& name);
     void endUndoSequence(String const& name);
 
+    // Bulk edits: use this when creating or removing lots of objects and connections at once
+    // The Pd lock is held until commit, all edits end up in a single undo step and the DSP graph is rebuilt once
+    // Because the audio thread waits until then, only put the Pd edits in a transaction, and update the GUI after committing
+    // On commit, the canvases showing this patch are synchronised once
+    void startTransaction(String const& name);
+    void commitTransaction();
+
     void undo();
     void redo();
 
@@ -132,6 +137,9 @@ private:
 
     WeakReference ptr;
 
+    int transactionDepth = 0;
+    String transactionName;
+
     // Initialisation parameters for GUI objects
     // Taken from pd save files, this will make sure that it directly initialises objects with the right parameters
     static inline const std::map<String, String> guiDefaults = {
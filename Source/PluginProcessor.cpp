@@ -18,7 +18,8 @@
 #include "Utility/SettingsFile.h"
 #include "Utility/PluginParameter.h"
 #include "Utility/OSUtils.h"
-#include "Utility/AudioSampleRingBuffer.h"
+#include "Utility/OutputLevelMeter.h"
+#include "Utility/SignalTap.h"
 #include "Utility/MidiDeviceManager.h"
 
 #include "Presets.h"
@@ -144,6 +145,7 @@ PluginProcessor::PluginProcessor()
 
     setProtectedMode(settingsFile->getProperty<int>("protected"));
     enableInternalSynth = settingsFile->getProperty<int>("internal_synth");
+    crossfadeDSPRebuild = settingsFile->getProperty<bool>("dsp_crossfade");
 
     auto currentThemeTree = settingsFile->getCurrentTheme();
 
@@ -397,6 +399,9 @@ void PluginProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 
     prepareDSP(getTotalNumInputChannels(), getTotalNumOutputChannels(), sampleRate * oversampleFactor, samplesPerBlock * oversampleFactor);
 
+    // About once per frame on a 60 Hz display
+    signalTapInterval = static_cast<int>(sampleRate * oversampleFactor / 60.0);
+
     oversampler = std::make_unique<dsp::Oversampling<float>>(maxChannels, oversampling, dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, false);
 
     oversampler->initProcessing(samplesPerBlock);
@@ -481,8 +486,12 @@ void PluginProcessor::processBlock(AudioBuffer<float>& buffer, MidiBuffer& midiM
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
     setThis();
-    sendPlayhead();
-    sendParameters();
+
+    // These would wait for the lock, we'll send them again once the DSP graph has been rebuilt
+    if (!isRebuildingDSP) {
+        sendPlayhead();
+        sendParameters();
+    }
 
     // Don't process if there are no samples, channels or we are suspended
     if(isSuspended() || buffer.getNumSamples() == 0 || buffer.getNumChannels() == 0) {
@@ -538,7 +547,7 @@ void PluginProcessor::processBlock(AudioBuffer<float>& buffer, MidiBuffer& midiM
     smoothedGain.applyGain(buffer, buffer.getNumSamples());
 
     statusbarSource->processBlock(midiBufferCopy, midiMessages, totalNumOutputChannels);
-    statusbarSource->peakBuffer.write(buffer);
+    statusbarSource->levelMeter.write(buffer);
 
     if (ProjectInfo::isStandalone) {
         for (auto bufferIterator : midiMessages) {
@@ -862,6 +871,14 @@ void PluginProcessor::processInternal()
 {
     setThis();
 
+    // When the message thread is rebuilding the DSP graph, we don't want to wait for it, since that would glitch the output
+    // Instead, we skip this block and pick up the new graph at the next block boundary
+    bool const lockedForDSPRebuild = isRebuildingDSP;
+    if (lockedForDSPRebuild && !tryLockAudioThread()) {
+        skipBlockForDSPRebuild();
+        return;
+    }
+
     // clear midi out
     if (producesMidi()) {
         midiByteIndex = 0;
@@ -877,7 +894,96 @@ void PluginProcessor::processInternal()
 
     // Process audio
     FloatVectorOperations::copy(audioBufferIn.data() + (2 * 64), audioBufferOut.data() + (2 * 64), (minOut - 2) * 64);
+
+    // Run the ticks we skipped during a DSP graph rebuild, so clocks and queued messages stay in time with the host
+    // Their audio output is overwritten by the tick below, but messages and midi they send still go out
+    if (numSkippedDSPBlocks > 0) {
+        // Don't try to catch up on more than about 100ms at once, that would only cause more dropouts
+        auto const maxCatchUpBlocks = std::max(1, static_cast<int>(getSampleRate() / (10 * Instance::getBlockSize())));
+        for (int i = 0; i < std::min(numSkippedDSPBlocks, maxCatchUpBlocks); i++) {
+            performDSP(audioBufferIn.data(), audioBufferOut.data());
+        }
+    }
+
     performDSP(audioBufferIn.data(), audioBufferOut.data());
+
+    samplesSinceSignalTap += Instance::getBlockSize();
+    if (samplesSinceSignalTap >= signalTapInterval) {
+        samplesSinceSignalTap = 0;
+        processSignalTaps();
+    }
+
+    if (lockedForDSPRebuild) {
+        unlockAudioThread();
+    }
+
+    // Fade into the new DSP graph
+    if (numSkippedDSPBlocks > 0) {
+        auto const blockSize = Instance::getBlockSize();
+        if (crossfadeDSPRebuild) {
+            for (int ch = 0; ch < getTotalNumOutputChannels(); ch++) {
+                auto* channel = audioBufferOut.data() + ch * blockSize;
+                for (int n = 0; n < blockSize; n++) {
+                    channel[n] *= static_cast<float>(n) / blockSize;
+                }
+            }
+        }
+        numSkippedDSPBlocks = 0;
+    }
+}
+
+void PluginProcessor::skipBlockForDSPRebuild()
+{
+    auto const blockSize = Instance::getBlockSize();
+    auto const numOut = getTotalNumOutputChannels();
+
+    // Fade out the last block we got from Pd, followed by silence until the new graph is ready
+    if (crossfadeDSPRebuild && numSkippedDSPBlocks == 0) {
+        for (int ch = 0; ch < numOut; ch++) {
+            auto* channel = audioBufferOut.data() + ch * blockSize;
+            for (int n = 0; n < blockSize; n++) {
+                channel[n] *= 1.0f - static_cast<float>(n + 1) / blockSize;
+            }
+        }
+    } else {
+        std::fill(audioBufferOut.begin(), audioBufferOut.end(), 0.0f);
+    }
+
+    // Make sure we don't send out the last midi block twice
+    if (producesMidi()) {
+        midiBufferOut.clear();
+    }
+
+    numSkippedDSPBlocks++;
+}
+
+void PluginProcessor::processSignalTaps()
+{
+    // Taps are added and removed with the audio lock held, and Pd only frees objects while holding it
+    // If the message thread has it right now, we don't wait for it and try again after the next block
+    if (!tryLockAudioThread()) {
+        return;
+    }
+
+    for (auto* tap : signalTaps) {
+        tap->process();
+    }
+
+    unlockAudioThread();
+}
+
+void PluginProcessor::addSignalTap(SignalTap* tap)
+{
+    lockAudioThread();
+    signalTaps.push_back(tap);
+    unlockAudioThread();
+}
+
+void PluginProcessor::removeSignalTap(SignalTap* tap)
+{
+    lockAudioThread();
+    signalTaps.erase(std::remove(signalTaps.begin(), signalTaps.end(), tap), signalTaps.end());
+    unlockAudioThread();
 }
 
 bool PluginProcessor::hasEditor() const
@@ -1233,6 +1339,14 @@ pd::Patch::Ptr PluginProcessor::loadPatch(String patchText, int splitIdx)
     return patch;
 }
 
+void PluginProcessor::propertyChanged(String const& name, var const& value)
+{
+    // Every instance listens, so the setting also applies to plugins that don't have an editor open
+    if (name == "dsp_crossfade") {
+        crossfadeDSPRebuild = static_cast<bool>(value);
+    }
+}
+
 void PluginProcessor::setTheme(String themeToUse, bool force)
 {
     auto oldThemeTree = settingsFile->getTheme(PlugDataLook::currentTheme);
@@ -1653,6 +1767,17 @@ void PluginProcessor::titleChanged()
     }
 }
 
+void PluginProcessor::patchTransactionCommitted(pd::Patch* patch)
+{
+    if (auto* editor = dynamic_cast<PluginEditor*>(getActiveEditor())) {
+        for (auto* cnv : editor->canvases) {
+            if (cnv->patch == *patch) {
+                cnv->synchronise();
+            }
+        }
+    }
+}
+
 void PluginProcessor::savePatchTabPositions()
 {
     Array<std::tuple<pd::Patch*, int>> sortedPatches;
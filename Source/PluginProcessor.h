@@ -9,6 +9,7 @@
 #include <juce_audio_devices/juce_audio_devices.h>
 #include <juce_dsp/juce_dsp.h>
 #include "Utility/Config.h"
+#include "Utility/SettingsFile.h"
 
 #include "Pd/Instance.h"
 #include "Pd/Patch.h"
@@ -20,10 +21,12 @@ class Library;
 class InternalSynth;
 class SettingsFile;
 class StatusbarSource;
+class SignalTap;
 class PlugDataLook;
 class PluginEditor;
 class PluginProcessor : public AudioProcessor
-    , public pd::Instance {
+    , public pd::Instance
+    , public SettingsFileListener {
 public:
     PluginProcessor();
 
@@ -73,6 +76,8 @@ public:
     void addTextToTextEditor(unsigned long ptr, String text) override;
     void showTextEditor(unsigned long ptr, Rectangle<int> bounds, String title) override;
 
+    void propertyChanged(String const& name, var const& value) override;
+
     void updateConsole() override;
 
     void reloadAbstractions(File changedPatch, t_glist* except) override;
@@ -114,6 +119,8 @@ public:
 
     void titleChanged() override;
 
+    void patchTransactionCommitted(pd::Patch* patch) override;
+
     void setTheme(String themeToUse, bool force = false);
 
     Colour getForegroundColour() override;
@@ -159,8 +166,17 @@ public:
     std::unique_ptr<InternalSynth> internalSynth;
     std::atomic<bool> enableInternalSynth = false;
 
+    // Fade out and back in when the audio thread has to skip blocks during a DSP graph rebuild
+    std::atomic<bool> crossfadeDSPRebuild = true;
+
+    // GUI objects that watch signals get their data from the audio thread through these, so they never have to lock to read it
+    void addSignalTap(SignalTap* tap);
+    void removeSignalTap(SignalTap* tap);
+
 private:
     void processInternal();
+    void skipBlockForDSPRebuild();
+    void processSignalTaps();
 
     SmoothedValue<float, ValueSmoothingTypes::Linear> smoothedGain;
 
@@ -168,6 +184,13 @@ private:
     std::vector<float> audioBufferIn;
     std::vector<float> audioBufferOut;
 
+    // Blocks that were skipped during a DSP graph rebuild, Pd's scheduler catches up on them afterwards
+    int numSkippedDSPBlocks = 0;
+
+    std::vector<SignalTap*> signalTaps;
+    int samplesSinceSignalTap = 0;
+    int signalTapInterval = 735;
+
     MidiBuffer midiBufferIn;
     MidiBuffer midiBufferOut;
     MidiBuffer midiBufferTemp;
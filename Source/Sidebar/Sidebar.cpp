@@ -108,6 +108,8 @@ Sidebar::~Sidebar()
 
 void Sidebar::paint(Graphics& g)
 {
+    PaintProfiler::startPaint(paintStatistics);
+
     // Sidebar
     g.setColour(findColour(PlugDataColour::sidebarBackgroundColourId));
     g.fillRect(0, 0, getWidth(), getHeight());
@@ -132,6 +134,10 @@ void Sidebar::paintOverChildren(Graphics& g)
     g.drawLine(0.5f, 0, 0.5f, getHeight() + 0.5f);
 
     g.drawLine(0, 60, getWidth(), 60);
+
+    // Only one panel is shown at a time, so we can attribute the paint time of the whole sidebar to it
+    if (paintStatistics.isMeasuring())
+        PaintProfiler::getInstance()->endPaint(paintStatistics, "Sidebar: " + (inspector->isVisible() ? String("Inspector") : panelNames[currentPanel]));
 }
 
 void Sidebar::resized()
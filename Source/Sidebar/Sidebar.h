@@ -7,6 +7,7 @@
 #pragma once
 #include "Constants.h"
 #include "Objects/ObjectParameters.h"
+#include "Utility/PaintProfiler.h"
 
 struct Console;
 struct Inspector;
@@ -90,4 +91,6 @@ private:
     bool pinned = false;
 
     int lastWidth = 250;
+
+    PaintProfiler::Statistics paintStatistics;
 };
@@ -585,7 +585,7 @@ void StatusbarSource::processBlock(MidiBuffer& midiIn, MidiBuffer& midiOut, int
 void StatusbarSource::prepareToPlay(int nChannels)
 {
     numChannels = nChannels;
-    peakBuffer.reset(sampleRate, bufferSize, nChannels);
+    levelMeter.reset(sampleRate, bufferSize, nChannels);
 }
 
 void StatusbarSource::timerCallback()
@@ -612,7 +612,7 @@ void StatusbarSource::timerCallback()
             listener->audioProcessedChanged(hasProcessedAudio);
     }
 
-    auto peak = peakBuffer.getPeak();
+    auto peak = levelMeter.getPeak();
 
     for (auto* listener : listeners) {
         listener->audioLevelChanged(peak);
@@ -9,7 +9,7 @@
 
 #include "Utility/SettingsFile.h"
 #include "Utility/ModifierKeyListener.h"
-#include "Utility/AudioSampleRingBuffer.h"
+#include "Utility/OutputLevelMeter.h"
 
 class Canvas;
 class LevelMeter;
@@ -44,7 +44,7 @@ public:
     void addListener(Listener* l);
     void removeListener(Listener* l);
 
-    AudioSampleRingBuffer peakBuffer;
+    OutputLevelMeter levelMeter;
 
 private:
     std::atomic<int> lastMidiReceivedTime = 0;
@@ -516,64 +516,6 @@ private:
 
         auto& library = currentObject->cnv->pd->objectLibrary;
 
-        class ObjectSorter {
-        public:
-            ObjectSorter(String searchQuery)
-                : query(searchQuery)
-            {
-            }
-
-            int compareElements(String const& a, String const& b)
-            {
-                // Check if suggestion exacly matches query
-                if (a == query) {
-                    return -1;
-                }
-
-                if (b == query) {
-                    return 1;
-                }
-
-                // Check if suggestion is equal to query with "~" appended
-                if (a == (query + "~") && b != query && b != (query + "~")) {
-                    return -1;
-                }
-
-                if (b == (query + "~") && a != query && a != (query + "~")) {
-                    return 1;
-                }
-
-                // Check if suggestion is equal to query with "." appended
-                if (a.startsWith(query + ".") && b != query && b != (query + "~") && !b.startsWith(query + ".")) {
-                    return -1;
-                }
-
-                if (b.startsWith(query + ".") && a != query && a != (query + "~") && !a.startsWith(query + ".")) {
-                    return 1;
-                }
-
-                if (a.length() < b.length()) {
-                    return -1;
-                }
-
-                if (b.length() < a.length()) {
-                    return 1;
-                }
-
-                return a.compareNatural(b);
-            }
-            const String query;
-        };
-
-        auto sortSuggestions = [](String query, StringArray suggestions) -> StringArray {
-            if (query.length() == 0)
-                return suggestions;
-
-            auto sorter = ObjectSorter(query);
-            suggestions.strings.sort(sorter);
-            return suggestions;
-        };
-
         // If there's a space, open arguments panel
         if (currentText.contains(" ")) {
             state = ShowingArguments;
@@ -647,18 +589,18 @@ private:
         if (!patchDir.isDirectory() || patchDir == File::getSpecialLocation(File::tempDirectory))
             patchDir = File();
 
-        // Update suggestions
+        // Update suggestions, these are already ranked by the library
         auto found = library->autocomplete(currentText, patchDir);
 
         // When hvcc mode is enabled, show only hvcc compatible objects
         filterNonHvccObjectsIfNeeded(found);
 
-        if (found.isEmpty()) {
+        // Only complete the text inline if the best match starts with it
+        if (found.isEmpty() || !found[0].startsWith(currentText)) {
             autoCompleteComponent->enableAutocomplete(false);
             deselectAll();
             currentidx = -1;
         } else {
-            found = sortSuggestions(currentText, found);
             currentidx = 0;
             autoCompleteComponent->enableAutocomplete(true);
         }
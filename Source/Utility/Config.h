@@ -26,6 +26,10 @@ struct ProjectInfo {
 
     static inline const File appDataDir = File::getSpecialLocation(File::SpecialLocationType::userDocumentsDirectory).getChildFile("plugdata");
 
+    // For files that plugdata writes by itself, like preview thumbnails and the library cache
+    // These can't go in appDataDir, because that folder is watched for changes to the user's abstractions
+    static inline const File cacheDir = File::getSpecialLocation(File::SpecialLocationType::userApplicationDataDirectory).getChildFile("plugdata");
+
     static inline const String versionSuffix = "-test";
     static inline const File versionDataDir = appDataDir.getChildFile("Versions").getChildFile(ProjectInfo::versionString + versionSuffix);
 };
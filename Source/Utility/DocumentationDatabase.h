@@ -0,0 +1,258 @@
+/*
+ // Copyright (c) 2021-2023 Timothy Schoen
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+
+#pragma once
+
+#include <BinaryData.h>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "DocumentationIndex.h"
+
+// Object documentation, read straight from the binary data embedded in the plugin
+// Only the positions of the objects in the data are read up front, every object is decoded to a ValueTree the first time it's needed
+// Load this through a SharedResourcePointer, so all plugin instances share the same decoded objects
+class DocumentationDatabase {
+public:
+    // The data is in JUCE's binary ValueTree format, written by Resources/Scripts/parse_documentation.py
+    explicit DocumentationDatabase(void const* binaryData = BinaryData::Documentation_bin, size_t binarySize = BinaryData::Documentation_binSize)
+        : data(static_cast<uint8 const*>(binaryData))
+        , size(binarySize)
+    {
+        Reader reader { data, size };
+
+        // The root tree only holds the objects
+        reader.skipString();
+        for (int i = reader.readCompressedInt(); i > 0 && !reader.failed; i--) {
+            reader.skipString();
+            reader.skipValue();
+        }
+
+        auto const numObjects = reader.readCompressedInt();
+        for (int i = 0; i < numObjects && !reader.failed; i++) {
+            Entry entry;
+            entry.offset = reader.position;
+
+            StringArray objectCategories;
+            readObject(reader, entry.name, objectCategories);
+            entry.size = reader.position - entry.offset;
+
+            if (reader.failed || entry.name.isEmpty())
+                continue;
+
+            auto const index = static_cast<int>(entries.size());
+            entries.push_back(entry);
+            entryByName.emplace(entry.name, index);
+
+            // ELSE and cyclone objects can also be created with their library in front, like else/knob or cyclone/gate
+            if (objectCategories.contains("ELSE"))
+                entryByName.emplace("else/" + entry.name, index);
+            if (objectCategories.contains("cyclone"))
+                entryByName.emplace("cyclone/" + entry.name, index);
+
+            for (auto const& category : objectCategories) {
+                categories.addIfNotAlreadyThere(category);
+            }
+        }
+
+        jassert(!reader.failed);
+    }
+
+    // Documentation of an object, or an invalid tree if it isn't documented
+    ValueTree getObjectInfo(String const& name)
+    {
+        auto found = entryByName.find(name);
+        if (found == entryByName.end())
+            return {};
+
+        std::lock_guard<std::mutex> lock(decodeLock);
+
+        auto& entry = entries[found->second];
+        if (!entry.decoded.isValid())
+            entry.decoded = decodeObject(found->second);
+
+        return entry.decoded;
+    }
+
+    StringArray const& getAllCategories() const { return categories; }
+
+    int getNumObjects() const { return static_cast<int>(entries.size()); }
+
+    // Decodes an object without keeping it, for going over all documentation once
+    ValueTree decodeObject(int index) const
+    {
+        auto const& entry = entries[index];
+        return ValueTree::readFromData(data + entry.offset, entry.size);
+    }
+
+    // The index for searching the documentation, built by the first instance that needs it
+    std::shared_ptr<DocumentationIndex const> getSearchIndex()
+    {
+        std::lock_guard<std::mutex> lock(indexLock);
+
+        if (!searchIndex) {
+            searchIndex = std::make_shared<DocumentationIndex const>(getNumObjects(), [this](int index) {
+                return decodeObject(index);
+            });
+        }
+
+        return searchIndex;
+    }
+
+private:
+    // Finds its way through JUCE's binary ValueTree format, without creating any trees
+    struct Reader {
+        uint8 const* data;
+        size_t size;
+        size_t position = 0;
+        bool failed = false;
+
+        // Same format as OutputStream::writeCompressedInt
+        int readCompressedInt()
+        {
+            if (position >= size) {
+                failed = true;
+                return 0;
+            }
+
+            auto const sizeByte = data[position++];
+            auto const numBytes = static_cast<size_t>(sizeByte & 0x7f);
+            if (numBytes > 4 || position + numBytes > size) {
+                failed = true;
+                return 0;
+            }
+
+            uint32 value = 0;
+            for (size_t i = 0; i < numBytes; i++) {
+                value |= static_cast<uint32>(data[position++]) << (8 * i);
+            }
+
+            auto const result = static_cast<int>(value);
+            return (sizeByte & 0x80) != 0 ? -result : result;
+        }
+
+        String readString()
+        {
+            auto const start = position;
+            skipString();
+            return failed ? String() : String::fromUTF8(reinterpret_cast<char const*>(data + start), static_cast<int>(position - start - 1));
+        }
+
+        void skipString()
+        {
+            while (position < size && data[position] != 0)
+                position++;
+
+            if (position >= size)
+                failed = true;
+            else
+                position++;
+        }
+
+        // Property values are stored as their size, followed by a type marker and the data
+        String readStringValue()
+        {
+            auto const numBytes = readCompressedInt();
+            if (numBytes < 0 || position + static_cast<size_t>(numBytes) > size) {
+                failed = true;
+                return {};
+            }
+
+            constexpr uint8 stringMarker = 5;
+
+            String result;
+            if (numBytes >= 2 && data[position] == stringMarker)
+                result = String::fromUTF8(reinterpret_cast<char const*>(data + position + 1), numBytes - 2);
+
+            position += static_cast<size_t>(numBytes);
+            return result;
+        }
+
+        void skipValue()
+        {
+            auto const numBytes = readCompressedInt();
+            if (numBytes < 0 || position + static_cast<size_t>(numBytes) > size)
+                failed = true;
+            else
+                position += static_cast<size_t>(numBytes);
+        }
+
+        void skipTree()
+        {
+            skipString();
+            skipTreeContents();
+        }
+
+        // Skips the properties and children of a tree whose type was already read
+        void skipTreeContents()
+        {
+            for (int i = readCompressedInt(); i > 0 && !failed; i--) {
+                skipString();
+                skipValue();
+            }
+            for (int i = readCompressedInt(); i > 0 && !failed; i--) {
+                skipTree();
+            }
+        }
+    };
+
+    // Reads the name and categories of an object, and skips everything else
+    static void readObject(Reader& reader, String& name, StringArray& objectCategories)
+    {
+        reader.skipString();
+        for (int i = reader.readCompressedInt(); i > 0 && !reader.failed; i--) {
+            if (reader.readString() == "name")
+                name = reader.readStringValue();
+            else
+                reader.skipValue();
+        }
+
+        for (int i = reader.readCompressedInt(); i > 0 && !reader.failed; i--) {
+            if (reader.readString() != "categories") {
+                reader.skipTreeContents();
+                continue;
+            }
+
+            for (int j = reader.readCompressedInt(); j > 0 && !reader.failed; j--) {
+                reader.skipString();
+                reader.skipValue();
+            }
+
+            for (int j = reader.readCompressedInt(); j > 0 && !reader.failed; j--) {
+                reader.skipString();
+                for (int k = reader.readCompressedInt(); k > 0 && !reader.failed; k--) {
+                    if (reader.readString() == "name")
+                        objectCategories.add(reader.readStringValue());
+                    else
+                        reader.skipValue();
+                }
+                for (int k = reader.readCompressedInt(); k > 0 && !reader.failed; k--) {
+                    reader.skipTree();
+                }
+            }
+        }
+    }
+
+    struct Entry {
+        String name;
+        size_t offset = 0;
+        size_t size = 0;
+        ValueTree decoded;
+    };
+
+    uint8 const* data;
+    size_t size;
+
+    std::vector<Entry> entries;
+    std::unordered_map<String, int> entryByName;
+    StringArray categories;
+
+    std::mutex decodeLock;
+
+    std::mutex indexLock;
+    std::shared_ptr<DocumentationIndex const> searchIndex;
+};
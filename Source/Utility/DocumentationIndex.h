@@ -0,0 +1,215 @@
+/*
+ // Copyright (c) 2021-2023 Timothy Schoen
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Inverted index over the object documentation, for searching objects by what they do
+// Every word in the documentation points to the objects it appears in, weighted by where it appears:
+// a word in the name of an object counts more than a word in its description, which counts more than one in an argument or iolet
+// The index is immutable once built, so it can be searched from any thread
+class DocumentationIndex {
+public:
+    // Building takes a while, so do it on a background thread
+    explicit DocumentationIndex(ValueTree const& documentation)
+        : DocumentationIndex(documentation.getNumChildren(), [&documentation](int index) {
+            return documentation.getChild(index);
+        })
+    {
+    }
+
+    // Indexes the objects one by one, so they don't all have to be decoded at the same time
+    DocumentationIndex(int numObjects, std::function<ValueTree(int)> const& getObject)
+    {
+        for (int i = 0; i < numObjects; i++) {
+            auto object = getObject(i);
+            auto name = object.getProperty("name").toString();
+            if (name.isEmpty())
+                continue;
+
+            std::unordered_map<String, float> weights;
+            auto addText = [&weights](String const& text, float weight) {
+                for (auto const& word : tokenise(text)) {
+                    auto& current = weights[word];
+                    current = std::max(current, weight);
+                }
+            };
+
+            addText(name, nameWeight);
+            addText(object.getProperty("description").toString(), descriptionWeight);
+
+            for (auto section : { "arguments", "methods", "flags", "iolets" }) {
+                for (auto item : object.getChildWithName(section)) {
+                    addText(item.getProperty("description").toString(), detailWeight);
+                    addText(item.getProperty("tooltip").toString(), detailWeight);
+                }
+            }
+
+            auto const objectIndex = static_cast<int>(objectNames.size());
+            objectNames.push_back(name);
+
+            for (auto& [word, weight] : weights) {
+                postings[word].push_back({ objectIndex, weight });
+            }
+        }
+
+        sortedWords.reserve(postings.size());
+        for (auto& [word, list] : postings) {
+            sortedWords.push_back(word);
+        }
+        std::sort(sortedWords.begin(), sortedWords.end());
+    }
+
+    // Objects that match all words of the query, best matches first
+    // The last word of the query may be incomplete, so it also matches all words that start with it
+    StringArray search(String const& query, int maxResults = -1) const
+    {
+        auto words = tokenise(query);
+
+        // The word that is still being typed, if the query doesn't end with a space or punctuation
+        auto const lowercase = query.toLowerCase();
+        auto partialWordStart = lowercase.length();
+        while (partialWordStart > 0 && CharacterFunctions::isLetterOrDigit(lowercase[partialWordStart - 1]))
+            partialWordStart--;
+
+        auto const partialWord = lowercase.substring(partialWordStart);
+
+        // It may look like a common word that tokenise left out, like "the" when typing "theme"
+        if (partialWord.isNotEmpty() && (words.isEmpty() || words[words.size() - 1] != normalise(partialWord)))
+            words.add(partialWord);
+
+        if (words.isEmpty() || objectNames.empty())
+            return {};
+
+        std::vector<float> scores(objectNames.size(), 0.0f);
+        std::vector<int> numMatchedWords(objectNames.size(), 0);
+        std::vector<float> wordScores(objectNames.size(), 0.0f);
+
+        for (int i = 0; i < words.size(); i++) {
+            std::fill(wordScores.begin(), wordScores.end(), 0.0f);
+
+            auto addPostings = [&](String const& word) {
+                auto found = postings.find(word);
+                if (found == postings.end())
+                    return;
+
+                // Words that appear in fewer objects say more about the object
+                auto const rarity = std::log(1.0f + static_cast<float>(objectNames.size()) / static_cast<float>(found->second.size()));
+                for (auto const& posting : found->second) {
+                    wordScores[posting.object] = std::max(wordScores[posting.object], posting.weight * rarity);
+                }
+            };
+
+            addPostings(words[i]);
+
+            if (i == words.size() - 1 && partialWord.isNotEmpty()) {
+                for (auto it = std::lower_bound(sortedWords.begin(), sortedWords.end(), partialWord); it != sortedWords.end() && it->startsWith(partialWord); ++it) {
+                    addPostings(*it);
+                }
+            }
+
+            for (size_t object = 0; object < objectNames.size(); object++) {
+                if (wordScores[object] > 0.0f) {
+                    scores[object] += wordScores[object];
+                    numMatchedWords[object]++;
+                }
+            }
+        }
+
+        std::vector<int> matches;
+        for (size_t object = 0; object < objectNames.size(); object++) {
+            if (numMatchedWords[object] == words.size())
+                matches.push_back(static_cast<int>(object));
+        }
+
+        std::sort(matches.begin(), matches.end(), [this, &scores](int a, int b) {
+            if (scores[a] != scores[b])
+                return scores[a] > scores[b];
+            if (objectNames[a].length() != objectNames[b].length())
+                return objectNames[a].length() < objectNames[b].length();
+
+            return objectNames[a] < objectNames[b];
+        });
+
+        StringArray result;
+        for (auto object : matches) {
+            if (maxResults >= 0 && result.size() >= maxResults)
+                break;
+
+            result.add(objectNames[object]);
+        }
+
+        return result;
+    }
+
+    // Splits text into lowercase words, without the most common English words, and with their endings normalised
+    static StringArray tokenise(String const& text)
+    {
+        static StringArray const stopWords = { "a", "an", "and", "are", "as", "at", "be", "by", "for", "from", "if", "in", "is", "it", "its", "of", "on", "or", "the", "this", "that", "to", "with" };
+
+        StringArray words;
+        auto const lowercase = text.toLowerCase();
+        auto wordStart = lowercase.getCharPointer();
+
+        for (auto c = wordStart;; ++c) {
+            if (c.isEmpty() || !CharacterFunctions::isLetterOrDigit(*c)) {
+                auto word = String(wordStart, c);
+                if (word.isNotEmpty() && !stopWords.contains(word))
+                    words.add(normalise(word));
+
+                if (c.isEmpty())
+                    break;
+
+                wordStart = c + 1;
+            }
+        }
+
+        return words;
+    }
+
+    // Very light stemming, so that plurals and verb forms find the same objects: "messages" -> "message", "sending" -> "send"
+    static String normalise(String const& word)
+    {
+        auto const length = word.length();
+
+        if (length > 4 && word.endsWith("ies"))
+            return word.dropLastCharacters(3) + "y";
+
+        if (length > 4 && (word.endsWith("sses") || word.endsWith("xes") || word.endsWith("ches") || word.endsWith("shes")))
+            return word.dropLastCharacters(2);
+
+        if (length > 3 && word.endsWith("s") && !word.endsWith("ss") && !word.endsWith("us") && !word.endsWith("is"))
+            return word.dropLastCharacters(1);
+
+        if (length > 5 && word.endsWith("ing"))
+            return word.dropLastCharacters(3);
+
+        if (length > 4 && word.endsWith("ed") && !word.endsWith("eed"))
+            return word.dropLastCharacters(2);
+
+        return word;
+    }
+
+private:
+    static constexpr float nameWeight = 8.0f;
+    static constexpr float descriptionWeight = 3.0f;
+    static constexpr float detailWeight = 1.0f;
+
+    struct Posting {
+        int object;
+        float weight;
+    };
+
+    std::vector<String> objectNames;
+    std::unordered_map<String, std::vector<Posting>> postings;
+
+    // All indexed words, sorted so we can find the words that start with an incomplete word
+    std::vector<String> sortedWords;
+};
@@ -0,0 +1,129 @@
+/*
+ // Copyright (c) 2021-2023 Timothy Schoen
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+
+#pragma once
+
+#include <list>
+#include <unordered_map>
+
+// Least-recently-used cache for blurred drop shadow images, limited by the total size of the images
+// When a new image doesn't fit in the budget, the images that weren't used for the longest time are removed first
+class DropShadowCache {
+public:
+    struct Statistics {
+        int64 hits = 0;
+        int64 misses = 0;
+        int64 evictions = 0;
+        size_t bytesUsed = 0;
+        size_t byteBudget = 0;
+        int numImages = 0;
+    };
+
+    explicit DropShadowCache(size_t maxBytes = 16 * 1024 * 1024)
+        : byteBudget(maxBytes)
+    {
+    }
+
+    // Returns a null image if there is nothing cached for this key
+    Image get(uint64 key)
+    {
+        SpinLock::ScopedLockType lock(cacheLock);
+
+        auto existing = lookup.find(key);
+        if (existing == lookup.end()) {
+            statistics.misses++;
+            return {};
+        }
+
+        statistics.hits++;
+
+        // Move to the front, so it will be removed last
+        entries.splice(entries.begin(), entries, existing->second);
+        return existing->second->image;
+    }
+
+    void add(uint64 key, Image const& image)
+    {
+        SpinLock::ScopedLockType lock(cacheLock);
+
+        auto bytes = getImageSize(image);
+
+        // Don't let one huge shadow flush the whole cache
+        if (bytes > byteBudget / 2)
+            return;
+
+        if (auto existing = lookup.find(key); existing != lookup.end()) {
+            bytesUsed -= existing->second->bytes;
+            entries.erase(existing->second);
+            lookup.erase(existing);
+        }
+
+        entries.push_front({ key, image, bytes });
+        lookup[key] = entries.begin();
+        bytesUsed += bytes;
+
+        evictToBudget();
+    }
+
+    void setByteBudget(size_t maxBytes)
+    {
+        SpinLock::ScopedLockType lock(cacheLock);
+        byteBudget = maxBytes;
+        evictToBudget();
+    }
+
+    void clear()
+    {
+        SpinLock::ScopedLockType lock(cacheLock);
+        entries.clear();
+        lookup.clear();
+        bytesUsed = 0;
+    }
+
+    Statistics getStatistics()
+    {
+        SpinLock::ScopedLockType lock(cacheLock);
+
+        auto result = statistics;
+        result.bytesUsed = bytesUsed;
+        result.byteBudget = byteBudget;
+        result.numImages = static_cast<int>(entries.size());
+        return result;
+    }
+
+private:
+    struct Entry {
+        uint64 key;
+        Image image;
+        size_t bytes;
+    };
+
+    void evictToBudget()
+    {
+        while (bytesUsed > byteBudget && !entries.empty()) {
+            auto& leastRecentlyUsed = entries.back();
+            bytesUsed -= leastRecentlyUsed.bytes;
+            lookup.erase(leastRecentlyUsed.key);
+            entries.pop_back();
+            statistics.evictions++;
+        }
+    }
+
+    static size_t getImageSize(Image const& image)
+    {
+        auto bytesPerPixel = image.getFormat() == Image::SingleChannel ? 1 : (image.getFormat() == Image::RGB ? 3 : 4);
+        return static_cast<size_t>(image.getWidth()) * static_cast<size_t>(image.getHeight()) * bytesPerPixel;
+    }
+
+    std::list<Entry> entries; // Most recently used first
+    std::unordered_map<uint64, std::list<Entry>::iterator> lookup;
+
+    size_t byteBudget;
+    size_t bytesUsed = 0;
+    Statistics statistics;
+
+    SpinLock cacheLock;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <BinaryData.h>
+#include "GlyphArrangementCache.h"
 
 enum FontStyle {
     Regular,
@@ -61,6 +62,9 @@ struct Fonts {
 
     static Font setCurrentFont(Font const& font) { return instance->currentTypeface = font.getTypefacePtr(); }
 
+    // Text layouts shared by everything that draws through these functions
+    static GlyphArrangementCache& getGlyphCache() { return instance->glyphCache; }
+
     // For drawing icons with icon font
     static void drawIcon(Graphics& g, String const& icon, Rectangle<int> bounds, Colour colour, int fontHeight = -1, bool centred = true)
     {
@@ -118,21 +122,19 @@ struct Fonts {
     static void drawStyledText(Graphics& g, String const& textToDraw, Rectangle<float> bounds, Colour colour, FontStyle style, int fontHeight = 15, Justification justification = Justification::centredLeft)
     {
         drawStyledTextSetup(g, colour, style, fontHeight);
-        g.drawText(textToDraw, bounds, justification);
+        getGlyphCache().drawSingleLineText(g, g.getCurrentFont(), textToDraw, bounds, justification);
     }
 
     // rectangle int version
     static void drawStyledText(Graphics& g, String const& textToDraw, Rectangle<int> bounds, Colour colour, FontStyle style, int fontHeight = 15, Justification justification = Justification::centredLeft)
     {
-        drawStyledTextSetup(g, colour, style, fontHeight);
-        g.drawText(textToDraw, bounds, justification);
+        drawStyledText(g, textToDraw, bounds.toFloat(), colour, style, fontHeight, justification);
     }
 
     // int version
     static void drawStyledText(Graphics& g, String const& textToDraw, int x, int y, int w, int h, Colour colour, FontStyle style, int fontHeight = 15, Justification justification = Justification::centredLeft)
     {
-        drawStyledTextSetup(g, colour, style, fontHeight);
-        g.drawText(textToDraw, Rectangle<int>(x, y, w, h), justification);
+        drawStyledText(g, textToDraw, Rectangle<float>(x, y, w, h), colour, style, fontHeight, justification);
     }
 
     // For drawing regular text
@@ -140,7 +142,7 @@ struct Fonts {
     {
         g.setFont(Fonts::getTabularNumbersFont().withHeight(fontHeight));
         g.setColour(colour);
-        g.drawText(textToDraw, bounds, justification);
+        getGlyphCache().drawSingleLineText(g, g.getCurrentFont(), textToDraw, bounds, justification);
     }
 
     static void drawTextWithTabularNumbers(Graphics& g, String const& textToDraw, Rectangle<int> bounds, Colour colour, int fontHeight = 15, Justification justification = Justification::centredLeft)
@@ -158,15 +160,13 @@ struct Fonts {
     {
         g.setFont(Fonts::getCurrentFont().withHeight(fontHeight));
         g.setColour(colour);
-        g.drawText(textToDraw, bounds, justification);
+        getGlyphCache().drawSingleLineText(g, g.getCurrentFont(), textToDraw, bounds, justification);
     }
 
     // For drawing regular text
     static void drawText(Graphics& g, String const& textToDraw, Rectangle<int> bounds, Colour colour, int fontHeight = 15, Justification justification = Justification::centredLeft)
     {
-        g.setFont(Fonts::getCurrentFont().withHeight(fontHeight));
-        g.setColour(colour);
-        g.drawText(textToDraw, bounds, justification);
+        drawText(g, textToDraw, bounds.toFloat(), colour, fontHeight, justification);
     }
 
     static void drawText(Graphics& g, String const& textToDraw, int x, int y, int w, int h, Colour colour, int fontHeight = 15, Justification justification = Justification::centredLeft)
@@ -178,7 +178,7 @@ struct Fonts {
     {
         g.setFont(getFontFromStyle(style).withHeight(fontHeight));
         g.setColour(colour);
-        g.drawFittedText(textToDraw, bounds, justification, numLines, minimumHoriontalScale);
+        getGlyphCache().drawFittedText(g, g.getCurrentFont(), textToDraw, bounds, justification, numLines, minimumHoriontalScale);
     }
 
     static void drawFittedText(Graphics& g, String const& textToDraw, int x, int y, int w, int h, Colour const& colour, int numLines = 1, float minimumHoriontalScale = 1.0f, int fontHeight = 15, Justification justification = Justification::centredLeft)
@@ -202,4 +202,6 @@ private:
     Typeface::Ptr monoTypeface;
     Typeface::Ptr variableTypeface;
     Typeface::Ptr tabularTypeface;
+
+    GlyphArrangementCache glyphCache;
 };
@@ -0,0 +1,167 @@
+/*
+ // Copyright (c) 2021-2023 Timothy Schoen
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+
+#pragma once
+
+#include <list>
+#include <unordered_map>
+
+// Least-recently-used cache of laid out text, shared by the whole editor
+// Patches often contain many objects with the same text, like [t b b] or [+ 1], so we only need to shape them once
+// Layouts are stored relative to the top left of the text area, so objects at different positions can share them
+// Only use this from the message thread
+class GlyphArrangementCache {
+public:
+    explicit GlyphArrangementCache(size_t maxEntries = 4096)
+        : maxEntries(maxEntries)
+    {
+    }
+
+    // Same result as Graphics::drawFittedText, with the current colour of the context
+    void drawFittedText(Graphics& g, Font const& font, String const& text, Rectangle<int> area, Justification justification, int maxLines, float minimumHorizontalScale)
+    {
+        if (text.isEmpty() || area.isEmpty() || !g.clipRegionIntersects(area))
+            return;
+
+        auto& entry = getEntry(Key(FittedText, text, font, area.getWidth(), area.getHeight(), justification.getFlags(), maxLines, minimumHorizontalScale), [&](Entry& newEntry) {
+            newEntry.glyphs.addFittedText(font, text, 0, 0, area.getWidth(), area.getHeight(), justification, maxLines, minimumHorizontalScale);
+        });
+
+        entry.glyphs.draw(g, AffineTransform::translation(area.getX(), area.getY()));
+    }
+
+    // Same result as Graphics::drawText, with the current colour of the context
+    void drawSingleLineText(Graphics& g, Font const& font, String const& text, Rectangle<float> area, Justification justification, bool useEllipsesIfTooBig = true)
+    {
+        if (text.isEmpty() || area.isEmpty() || !g.clipRegionIntersects(area.getSmallestIntegerContainer()))
+            return;
+
+        auto& entry = getEntry(Key(SingleLineText, text, font, area.getWidth(), area.getHeight(), justification.getFlags(), useEllipsesIfTooBig, 0.0f), [&](Entry& newEntry) {
+            newEntry.glyphs.addCurtailedLineOfText(font, text, 0.0f, 0.0f, area.getWidth(), useEllipsesIfTooBig);
+            newEntry.glyphs.justifyGlyphs(0, newEntry.glyphs.getNumGlyphs(), 0.0f, 0.0f, area.getWidth(), area.getHeight(), justification);
+        });
+
+        entry.glyphs.draw(g, AffineTransform::translation(area.getX(), area.getY()));
+    }
+
+    // Same result as Font::getStringWidthFloat
+    float getStringWidth(Font const& font, String const& text)
+    {
+        if (text.isEmpty())
+            return 0.0f;
+
+        return getEntry(Key(StringWidth, text, font, 0.0f, 0.0f, 0, 0, 0.0f), [&](Entry& newEntry) {
+            newEntry.width = font.getStringWidthFloat(text);
+        }).width;
+    }
+
+    void clear()
+    {
+        entries.clear();
+        lookup.clear();
+    }
+
+private:
+    enum LayoutType {
+        FittedText,
+        SingleLineText,
+        StringWidth
+    };
+
+    struct Key {
+        Key(LayoutType layoutType, String const& layoutText, Font const& font, float areaWidth, float areaHeight, int justificationFlags, int lines, float minimumScale)
+            : type(layoutType)
+            , text(layoutText)
+            , typeface(font.getTypefacePtr().get())
+            , typefaceName(font.getTypefaceName())
+            , typefaceStyle(font.getTypefaceStyle())
+            , fontHeight(font.getHeight())
+            , horizontalScale(font.getHorizontalScale())
+            , kerning(font.getExtraKerningFactor())
+            , width(areaWidth)
+            , height(areaHeight)
+            , justification(justificationFlags)
+            , maxLines(lines)
+            , minimumHorizontalScale(minimumScale)
+        {
+        }
+
+        bool operator==(Key const& other) const
+        {
+            return type == other.type && text == other.text && typeface == other.typeface && typefaceName == other.typefaceName && typefaceStyle == other.typefaceStyle && fontHeight == other.fontHeight && horizontalScale == other.horizontalScale && kerning == other.kerning && width == other.width && height == other.height && justification == other.justification && maxLines == other.maxLines && minimumHorizontalScale == other.minimumHorizontalScale;
+        }
+
+        LayoutType type;
+        String text;
+        Typeface* typeface;
+        String typefaceName;
+        String typefaceStyle;
+        float fontHeight;
+        float horizontalScale;
+        float kerning;
+        float width;
+        float height;
+        int justification;
+        int maxLines;
+        float minimumHorizontalScale;
+    };
+
+    struct KeyHash {
+        size_t operator()(Key const& key) const
+        {
+            auto hash = static_cast<size_t>(key.text.hashCode64());
+            auto combine = [&hash](size_t value) {
+                hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            };
+
+            combine(static_cast<size_t>(key.type));
+            combine(std::hash<Typeface*>()(key.typeface));
+            combine(std::hash<float>()(key.fontHeight));
+            combine(std::hash<float>()(key.width));
+            combine(std::hash<float>()(key.height));
+            combine(static_cast<size_t>(key.justification));
+            combine(static_cast<size_t>(key.maxLines));
+            return hash;
+        }
+    };
+
+    struct Entry {
+        Key key;
+        GlyphArrangement glyphs;
+        float width = 0.0f;
+    };
+
+    template<typename LayoutFunction>
+    Entry& getEntry(Key&& key, LayoutFunction layout)
+    {
+        if (auto existing = lookup.find(key); existing != lookup.end()) {
+            // Move to the front, so it will be removed last
+            entries.splice(entries.begin(), entries, existing->second);
+            return *existing->second;
+        }
+
+        entries.push_front({ std::move(key), {}, 0.0f });
+        auto& entry = entries.front();
+
+        layout(entry);
+
+        lookup.emplace(entry.key, entries.begin());
+
+        while (entries.size() > maxEntries) {
+            lookup.erase(entries.back().key);
+            entries.pop_back();
+        }
+
+        return entry;
+    }
+
+    size_t maxEntries;
+
+    std::list<Entry> entries; // Most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup;
+
+    JUCE_DECLARE_NON_COPYABLE(GlyphArrangementCache)
+};
@@ -0,0 +1,139 @@
+/*
+ // Copyright (c) 2021-2023 Timothy Schoen
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+
+#pragma once
+
+#include <limits>
+#include <vector>
+
+// Multi-resolution minimum and maximum of a signal, used for drawing large arrays
+// The first level stores the range of every block of samples, and every next level combines two entries of the level below
+// Finding the range of any part of the signal then costs a few lookups, instead of touching every sample
+class MinMaxPyramid {
+public:
+    static constexpr size_t blockSize = 64;
+
+    struct Range {
+        float min = std::numeric_limits<float>::max();
+        float max = std::numeric_limits<float>::lowest();
+
+        void include(float value)
+        {
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+
+        void include(Range const& other)
+        {
+            min = std::min(min, other.min);
+            max = std::max(max, other.max);
+        }
+
+        bool isEmpty() const { return min > max; }
+    };
+
+    void rebuild(float const* samples, size_t numSamples)
+    {
+        size = numSamples;
+        levels.clear();
+
+        if (size == 0)
+            return;
+
+        levels.emplace_back((size + blockSize - 1) / blockSize);
+        while (levels.back().size() > 1) {
+            levels.emplace_back((levels.back().size() + 1) / 2);
+        }
+
+        update(samples, numSamples, 0, numSamples);
+    }
+
+    // Recalculates the blocks that overlap the samples in [start, end)
+    void update(float const* samples, size_t numSamples, size_t start, size_t end)
+    {
+        if (numSamples != size) {
+            rebuild(samples, numSamples);
+            return;
+        }
+
+        end = std::min(end, size);
+        if (start >= end)
+            return;
+
+        auto firstBlock = start / blockSize;
+        auto lastBlock = (end - 1) / blockSize;
+
+        for (auto block = firstBlock; block <= lastBlock; block++) {
+            Range range;
+            auto blockEnd = std::min(size, (block + 1) * blockSize);
+            for (auto i = block * blockSize; i < blockEnd; i++) {
+                range.include(samples[i]);
+            }
+            levels[0][block] = range;
+        }
+
+        for (size_t level = 1; level < levels.size(); level++) {
+            firstBlock /= 2;
+            lastBlock /= 2;
+
+            auto& below = levels[level - 1];
+            for (auto block = firstBlock; block <= lastBlock; block++) {
+                auto range = below[block * 2];
+                if (block * 2 + 1 < below.size())
+                    range.include(below[block * 2 + 1]);
+
+                levels[level][block] = range;
+            }
+        }
+    }
+
+    // Gets the minimum and maximum of the samples in [start, end)
+    Range getRange(float const* samples, size_t start, size_t end) const
+    {
+        Range range;
+        end = std::min(end, size);
+        if (start >= end)
+            return range;
+
+        auto firstBlock = (start + blockSize - 1) / blockSize;
+        auto endBlock = end / blockSize;
+
+        // The range doesn't contain a whole block, so just check the samples
+        if (firstBlock >= endBlock) {
+            for (auto i = start; i < end; i++) {
+                range.include(samples[i]);
+            }
+            return range;
+        }
+
+        // Samples before the first and after the last whole block
+        for (auto i = start; i < firstBlock * blockSize; i++) {
+            range.include(samples[i]);
+        }
+        for (auto i = endBlock * blockSize; i < end; i++) {
+            range.include(samples[i]);
+        }
+
+        // Whole blocks, using the coarsest level that fits
+        for (size_t level = 0; firstBlock < endBlock; level++) {
+            if (firstBlock & 1)
+                range.include(levels[level][firstBlock++]);
+            if (endBlock & 1)
+                range.include(levels[level][--endBlock]);
+
+            firstBlock /= 2;
+            endBlock /= 2;
+        }
+
+        return range;
+    }
+
+    size_t getNumSamples() const { return size; }
+
+private:
+    std::vector<std::vector<Range>> levels;
+    size_t size = 0;
+};
@@ -27,6 +27,10 @@ OfflineObjectRenderer::OfflineObjectRenderer(pd::Instance* instance)
     auto const* file = filename.toRawUTF8();
 
     offlineCnv = static_cast<t_canvas*>(libpd_create_canvas(file, dir));
+
+    previewThread.addJob([]() {
+        prunePreviewCache();
+    });
 }
 
 OfflineObjectRenderer::~OfflineObjectRenderer() = default;
@@ -38,13 +42,92 @@ OfflineObjectRenderer* OfflineObjectRenderer::findParentOfflineObjectRendererFor
 
 ImageWithOffset OfflineObjectRenderer::patchToTempImage(String const& patch, float scale)
 {
+    auto colour = LookAndFeel::getDefaultLookAndFeel().findColour(PlugDataColour::objectSelectedOutlineColourId);
+    auto key = getPreviewKey(patch, scale, colour);
+
+    if (auto cached = previewCache.find(key); cached != previewCache.end()) {
+        return cached->second;
+    }
+
+    auto preview = loadPreviewFromDisk(key);
+    if (preview.image.isNull()) {
+        auto [objectRects, totalSize] = getObjectBounds(patch);
+        preview = renderPreview(objectRects, totalSize, scale, colour);
+        savePreviewToDisk(key, preview);
+    }
+
+    addToMemoryCache(key, preview);
+    return preview;
+}
+
+ImageWithOffset OfflineObjectRenderer::getPreviewAsync(String const& patch, float scale, std::function<void(ImageWithOffset const&)> onReady)
+{
+    auto colour = LookAndFeel::getDefaultLookAndFeel().findColour(PlugDataColour::objectSelectedOutlineColourId);
+    auto key = getPreviewKey(patch, scale, colour);
+
+    if (auto cached = previewCache.find(key); cached != previewCache.end()) {
+        return cached->second;
+    }
+
+    // If this preview is already being rendered, only add the callback
+    auto& callbacks = pendingPreviews[key];
+    callbacks.push_back(std::move(onReady));
+    if (callbacks.size() > 1)
+        return {};
+
+    previewThread.addJob([key, patch, scale, colour, _this = juce::WeakReference<OfflineObjectRenderer>(this)]() {
+        auto preview = loadPreviewFromDisk(key);
+        if (!preview.image.isNull()) {
+            previewReady(_this, key, preview);
+            return;
+        }
+
+        // Measuring the objects means creating them in Pd, which we only do on the message thread
+        MessageManager::callAsync([_this, key, patch, scale, colour]() {
+            if (!_this)
+                return;
+
+            auto objectBounds = _this->getObjectBounds(patch);
+
+            _this->previewThread.addJob([_this, key, objectBounds, scale, colour]() {
+                auto preview = renderPreview(objectBounds.first, objectBounds.second, scale, colour);
+                savePreviewToDisk(key, preview);
+                previewReady(_this, key, preview);
+            });
+        });
+    });
+
+    return {};
+}
+
+void OfflineObjectRenderer::previewReady(WeakReference<OfflineObjectRenderer> renderer, String const& key, ImageWithOffset const& preview)
+{
+    MessageManager::callAsync([renderer, key, preview]() {
+        if (!renderer)
+            return;
+
+        renderer->addToMemoryCache(key, preview);
+
+        auto callbacks = std::move(renderer->pendingPreviews[key]);
+        renderer->pendingPreviews.erase(key);
+
+        for (auto& callback : callbacks) {
+            if (callback)
+                callback(preview);
+        }
+    });
+}
+
+std::pair<Array<Rectangle<int>>, Rectangle<int>> OfflineObjectRenderer::getObjectBounds(String const& patch)
+{
+    Array<Rectangle<int>> objectRects;
+    Rectangle<int> totalSize;
+
     pd->setThis();
 
     sys_lock();
     pd->muteConsole(true);
 
-    objectRects.clear();
-    totalSize.setBounds(0, 0, 0, 0);
     int obj_x, obj_y, obj_w, obj_h;
     auto rect = Rectangle<int>();
     libpd_paste(offlineCnv, stripConnections(patch).toRawUTF8());
@@ -74,17 +157,20 @@ ImageWithOffset OfflineObjectRenderer::patchToTempImage(String const& patch, flo
     pd->muteConsole(false);
     sys_unlock();
 
-    // apply the top left offset to all rects
-    for (auto& rect : objectRects) {
-        rect.translate(-totalSize.getX(), -totalSize.getY());
-    }
+    return { objectRects, totalSize };
+}
+
+ImageWithOffset OfflineObjectRenderer::renderPreview(Array<Rectangle<int>> const& objectRects, Rectangle<int> totalSize, float scale, Colour colour)
+{
     auto size = Point<int>(totalSize.getWidth(), totalSize.getHeight());
-    Image image(Image::ARGB, totalSize.getWidth() * scale, totalSize.getHeight() * scale, true);
+    Image image(Image::ARGB, jmax(1, roundToInt(totalSize.getWidth() * scale)), jmax(1, roundToInt(totalSize.getHeight() * scale)), true);
     Graphics g(image);
     g.addTransform(AffineTransform::scale(scale));
-    g.setColour(LookAndFeel::getDefaultLookAndFeel().findColour(PlugDataColour::objectSelectedOutlineColourId));
-    for (auto& rect : objectRects) {
-        g.fillRoundedRectangle(rect.toFloat(), 5.0f);
+    g.setColour(colour);
+
+    // apply the top left offset to all rects
+    for (auto rect : objectRects) {
+        g.fillRoundedRectangle(rect.translated(-totalSize.getX(), -totalSize.getY()).toFloat(), 5.0f);
     }
     // ALEX TODO we shouldn't apply alpha here! Do it in the zoomableDragAndDropContainer
     image.multiplyAllAlphas(0.3f);
@@ -92,6 +178,78 @@ ImageWithOffset OfflineObjectRenderer::patchToTempImage(String const& patch, flo
     return ImageWithOffset(image, size);
 }
 
+String OfflineObjectRenderer::getPreviewKey(String const& patch, float scale, Colour colour)
+{
+    return String::toHexString(static_cast<int64>(patch.hashCode64())) + "_" + colour.toString() + "_" + String(roundToInt(scale * 100.0f));
+}
+
+File OfflineObjectRenderer::getPreviewCacheDir()
+{
+    return ProjectInfo::cacheDir.getChildFile("Thumbnails");
+}
+
+// Preview files are named <key>_<width>_<height>.png, so we can get the size without opening them
+ImageWithOffset OfflineObjectRenderer::loadPreviewFromDisk(String const& key)
+{
+    auto files = getPreviewCacheDir().findChildFiles(File::findFiles, false, key + "_*.png");
+    if (files.isEmpty())
+        return {};
+
+    auto sizeTokens = StringArray::fromTokens(files[0].getFileNameWithoutExtension().fromFirstOccurrenceOf(key + "_", false, false), "_", "");
+    auto image = PNGImageFormat::loadFrom(files[0]);
+    if (image.isNull() || sizeTokens.size() != 2) {
+        files[0].deleteFile();
+        return {};
+    }
+
+    // Keeps recently used previews from being pruned
+    files[0].setLastModificationTime(Time::getCurrentTime());
+
+    return ImageWithOffset(image, Point<int>(sizeTokens[0].getIntValue(), sizeTokens[1].getIntValue()));
+}
+
+void OfflineObjectRenderer::savePreviewToDisk(String const& key, ImageWithOffset const& preview)
+{
+    auto previewCacheDir = getPreviewCacheDir();
+    if (!previewCacheDir.isDirectory() && !previewCacheDir.createDirectory())
+        return;
+
+    auto file = previewCacheDir.getChildFile(key + "_" + String(preview.offset.x) + "_" + String(preview.offset.y) + ".png");
+
+    // Write to a temporary file first, so other instances never read a half-written preview
+    TemporaryFile tempFile(file);
+    if (auto stream = tempFile.getFile().createOutputStream()) {
+        PNGImageFormat png;
+        if (!png.writeImageToStream(preview.image, *stream))
+            return;
+    }
+    tempFile.overwriteTargetFileWithTemporary();
+}
+
+void OfflineObjectRenderer::prunePreviewCache()
+{
+    auto files = getPreviewCacheDir().findChildFiles(File::findFiles, false, "*.png");
+    if (files.size() <= maxPreviewsOnDisk)
+        return;
+
+    std::sort(files.begin(), files.end(), [](File const& a, File const& b) {
+        return a.getLastModificationTime() > b.getLastModificationTime();
+    });
+
+    for (int i = maxPreviewsOnDisk; i < files.size(); i++) {
+        files.getReference(i).deleteFile();
+    }
+}
+
+void OfflineObjectRenderer::addToMemoryCache(String const& key, ImageWithOffset const& preview)
+{
+    // Previews are small, but don't let the cache grow forever when the theme or zoom changes a lot
+    if (previewCache.size() > 512)
+        previewCache.clear();
+
+    previewCache[key] = preview;
+}
+
 bool OfflineObjectRenderer::checkIfPatchIsValid(String const& patch)
 {
     pd->setThis();
@@ -137,7 +295,7 @@ String OfflineObjectRenderer::stripConnections(String const& patch)
     return strippedPatch;
 }
 
-std::pair<std::vector<bool>, std::vector<bool>> OfflineObjectRenderer::countIolets(String const& patch)
+OfflineObjectRenderer::Iolets OfflineObjectRenderer::countIolets(String const& patch)
 {
     std::vector<bool> inlets;
     std::vector<bool> outlets;
@@ -165,3 +323,11 @@ std::pair<std::vector<bool>, std::vector<bool>> OfflineObjectRenderer::countIole
 
     return std::make_pair(inlets, outlets);
 }
+
+void OfflineObjectRenderer::countIoletsAsync(String const& patch, std::function<void(Iolets const&)> onReady)
+{
+    MessageManager::callAsync([patch, onReady, _this = juce::WeakReference<OfflineObjectRenderer>(this)]() {
+        if (_this && onReady)
+            onReady(_this->countIolets(patch));
+    });
+}
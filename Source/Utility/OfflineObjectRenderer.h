@@ -20,22 +20,61 @@ public:
 
 class OfflineObjectRenderer {
 public:
+    using Iolets = std::pair<std::vector<bool>, std::vector<bool>>;
+
     OfflineObjectRenderer(pd::Instance* pd);
     virtual ~OfflineObjectRenderer();
 
     static OfflineObjectRenderer* findParentOfflineObjectRendererFor(Component* childComponent);
 
+    // Renders a preview image of the patch, or gets it from the preview cache
     ImageWithOffset patchToTempImage(String const& patch, float scale);
 
+    // Returns the preview if it's already in the memory cache
+    // Otherwise, loads it from disk or renders it, and calls onReady on the message thread when done
+    // Only loading and drawing the image happens on a background thread, the objects are measured in Pd on the message thread
+    // Until then, the caller should draw a placeholder
+    ImageWithOffset getPreviewAsync(String const& patch, float scale, std::function<void(ImageWithOffset const&)> onReady);
+
     bool checkIfPatchIsValid(String const& patch);
 
-    std::pair<std::vector<bool>, std::vector<bool>> countIolets(String const& patch);
+    Iolets countIolets(String const& patch);
+
+    // Counts the iolets later on the message thread, so creating lots of palette items doesn't wait for Pd
+    void countIoletsAsync(String const& patch, std::function<void(Iolets const&)> onReady);
 
 private:
     String stripConnections(String const& patch);
 
-    Array<Rectangle<int>> objectRects;
-    Rectangle<int> totalSize;
+    std::pair<Array<Rectangle<int>>, Rectangle<int>> getObjectBounds(String const& patch);
+    static ImageWithOffset renderPreview(Array<Rectangle<int>> const& objectRects, Rectangle<int> totalSize, float scale, Colour colour);
+
+    // Previews are cached on disk, keyed by a hash of the patch content, the theme colour and the scale
+    static String getPreviewKey(String const& patch, float scale, Colour colour);
+    static ImageWithOffset loadPreviewFromDisk(String const& key);
+    static void savePreviewToDisk(String const& key, ImageWithOffset const& preview);
+
+    // Removes the least recently used previews when there are too many of them
+    static void prunePreviewCache();
+
+    static void previewReady(WeakReference<OfflineObjectRenderer> renderer, String const& key, ImageWithOffset const& preview);
+
+    void addToMemoryCache(String const& key, ImageWithOffset const& preview);
+
     t_glist* offlineCnv = nullptr;
     pd::Instance* pd;
+
+    std::map<String, ImageWithOffset> previewCache;
+    std::map<String, std::vector<std::function<void(ImageWithOffset const&)>>> pendingPreviews;
+
+    static File getPreviewCacheDir();
+
+    static inline constexpr int maxPreviewsOnDisk = 1000;
+
+    // Loads and draws previews in the background
+    // Declared last, so its jobs are finished before anything else is destroyed
+    ThreadPool previewThread = ThreadPool(1);
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE(OfflineObjectRenderer)
+    JUCE_DECLARE_NON_COPYABLE(OfflineObjectRenderer)
 };
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <atomic>
+
+/*
+    Single producer, single consumer level meter for the output
+
+    The audio thread updates the peak level of the current window (1/60 of a second) as it goes.
+    When a window is complete, its peak is published through atomics, so reading it never blocks
+    the audio thread and never touches the samples.
+
+    A published peak stays until a newer window replaces it. Until the GUI has read it, newer windows can
+    only raise it, so short transients don't get lost between frames. When the host sends large blocks,
+    windows are completed in bursts, and the meter keeps showing the last peak in between.
+*/
+
+class OutputLevelMeter {
+public:
+    static constexpr int maxChannels = 2;
+
+    OutputLevelMeter()
+    {
+    }
+
+    // Not called while the audio thread is writing
+    void reset(double sourceSampleRate, int sourceBufferSize, int numChannels)
+    {
+        ignoreUnused(sourceBufferSize);
+
+        windowSize = std::max(1, static_cast<int>(sourceSampleRate / 60));
+        channels = jlimit(0, maxChannels, numChannels);
+
+        windowPosition = 0;
+        for (int ch = 0; ch < maxChannels; ch++) {
+            windowPeak[ch] = 0.0f;
+            peak[ch].store(0.0f);
+            peakWasRead[ch].store(true);
+        }
+    }
+
+    // Audio thread only, wait-free
+    void write(AudioBuffer<float>& samples)
+    {
+        auto const numSamples = samples.getNumSamples();
+        auto const numChannels = std::min(channels, samples.getNumChannels());
+
+        // Update the peak one window at a time
+        for (int offset = 0; offset < numSamples;) {
+            auto const length = std::min(numSamples - offset, windowSize - windowPosition);
+
+            for (int ch = 0; ch < numChannels; ch++) {
+                auto const* data = samples.getReadPointer(ch, offset);
+                auto const range = FloatVectorOperations::findMinAndMax(data, length);
+                windowPeak[ch] = std::max({ windowPeak[ch], -range.getStart(), range.getEnd() });
+            }
+
+            offset += length;
+            windowPosition += length;
+
+            if (windowPosition == windowSize) {
+                publishWindow(numChannels);
+            }
+        }
+    }
+
+    // Peak of the most recent windows, square-rooted for display
+    Array<float> getPeak()
+    {
+        Array<float> result;
+        for (int ch = 0; ch < maxChannels; ch++) {
+            result.add(std::sqrt(peak[ch].load()));
+            peakWasRead[ch].store(true);
+        }
+        return result;
+    }
+
+private:
+    void publishWindow(int numChannels)
+    {
+        for (int ch = 0; ch < numChannels; ch++) {
+            if (peakWasRead[ch].exchange(false)) {
+                peak[ch].store(windowPeak[ch]);
+            } else {
+                // Keep the highest peak until the GUI reads it
+                auto held = peak[ch].load(std::memory_order_relaxed);
+                while (windowPeak[ch] > held && !peak[ch].compare_exchange_weak(held, windowPeak[ch])) { }
+            }
+
+            windowPeak[ch] = 0.0f;
+        }
+
+        windowPosition = 0;
+    }
+
+    int windowSize = 1;
+    int channels = 0;
+
+    // Only used by the audio thread
+    int windowPosition = 0;
+    float windowPeak[maxChannels] = { 0.0f };
+
+    std::atomic<float> peak[maxChannels] {};
+    std::atomic<bool> peakWasRead[maxChannels] {};
+};
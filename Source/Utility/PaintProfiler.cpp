@@ -0,0 +1,148 @@
+/*
+ // Copyright (c) 2021-2023 Timothy Schoen
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include "PaintProfiler.h"
+
+JUCE_IMPLEMENT_SINGLETON(PaintProfiler)
+
+PaintProfiler::~PaintProfiler()
+{
+    // Paints after shutdown shouldn't create the profiler again
+    enabled = false;
+    clearSingletonInstance();
+}
+
+void PaintProfiler::endPaint(Statistics& statistics, String const& className, bool isFrame)
+{
+    // Profiling was turned on halfway through the paint
+    if (!statistics.startTicks)
+        return;
+
+    auto paintMs = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - statistics.startTicks) * 1000.0;
+    statistics.startTicks = 0;
+
+    statistics.lastPaintMs = paintMs;
+    statistics.averagePaintMs = statistics.averagePaintMs == 0.0 ? paintMs : statistics.averagePaintMs * 0.9 + paintMs * 0.1;
+
+    auto now = Time::getMillisecondCounter();
+    if (now - statistics.windowStart >= 1000) {
+        statistics.paintsPerSecond = statistics.windowStart == 0 ? 0.0f : statistics.paintsInWindow * 1000.0f / static_cast<float>(now - statistics.windowStart);
+        statistics.paintsInWindow = 0;
+        statistics.windowStart = now;
+    }
+    statistics.paintsInWindow++;
+    statistics.lastPaintTime = now;
+
+    auto& forClass = classStatistics[className];
+    forClass.paints++;
+    forClass.totalMs += paintMs;
+    forClass.maxMs = std::max(forClass.maxMs, paintMs);
+
+    if (isFrame)
+        frameTimes.push_back(paintMs);
+}
+
+void PaintProfiler::addOverlay(Component* overlay, std::function<void(String const&)> log)
+{
+    removeOverlay(overlay);
+    overlays.push_back({ overlay, std::move(log) });
+
+    if (!enabled) {
+        enabled = true;
+        secondsSinceLastLog = 0;
+        classStatistics.clear();
+        frameTimes.clear();
+        startTimer(1000);
+    }
+}
+
+void PaintProfiler::removeOverlay(Component* overlay)
+{
+    overlays.erase(std::remove_if(overlays.begin(), overlays.end(), [overlay](Overlay const& existing) {
+        return existing.component == nullptr || existing.component.getComponent() == overlay;
+    }),
+        overlays.end());
+
+    if (overlays.empty()) {
+        enabled = false;
+        stopTimer();
+    }
+}
+
+Colour PaintProfiler::getHeatColour(Statistics const& statistics)
+{
+    // Components that stopped repainting only count with their paint time
+    auto recentlyPainted = Time::getMillisecondCounter() - statistics.lastPaintTime < 2000;
+    auto msPerSecond = recentlyPainted ? statistics.averagePaintMs * statistics.paintsPerSecond : 0.0;
+
+    auto heat = static_cast<float>(jlimit(0.0, 1.0, std::max(msPerSecond / 20.0, statistics.averagePaintMs / 4.0)));
+    return Colours::green.interpolatedWith(Colours::red, heat).withAlpha(0.2f + 0.4f * heat);
+}
+
+String PaintProfiler::getDescription(Statistics const& statistics)
+{
+    auto recentlyPainted = Time::getMillisecondCounter() - statistics.lastPaintTime < 2000;
+    return String(statistics.averagePaintMs, 2) + " ms, " + String(recentlyPainted ? roundToInt(statistics.paintsPerSecond) : 0) + "/s";
+}
+
+String PaintProfiler::getReport()
+{
+    if (frameTimes.empty())
+        return {};
+
+    std::sort(frameTimes.begin(), frameTimes.end());
+    auto percentile = [this](double fraction) {
+        return frameTimes[std::min(frameTimes.size() - 1, static_cast<size_t>(fraction * frameTimes.size()))];
+    };
+
+    auto report = "Paint profiler: " + String(static_cast<int>(frameTimes.size())) + " frames, p50 " + String(percentile(0.5), 2) + " ms, p90 " + String(percentile(0.9), 2) + " ms, p99 " + String(percentile(0.99), 2) + " ms, max " + String(frameTimes.back(), 2) + " ms";
+
+    // List the classes that took most of the paint time
+    std::vector<std::pair<String, ClassStatistics>> slowest(classStatistics.begin(), classStatistics.end());
+    std::sort(slowest.begin(), slowest.end(), [](auto const& a, auto const& b) {
+        return a.second.totalMs > b.second.totalMs;
+    });
+
+    for (int i = 0; i < std::min<int>(5, slowest.size()); i++) {
+        auto& [className, statistics] = slowest[i];
+        report += "\n    " + className + ": " + String(statistics.totalMs, 2) + " ms in " + String(statistics.paints) + " paints, max " + String(statistics.maxMs, 2) + " ms";
+    }
+
+    return report;
+}
+
+void PaintProfiler::timerCallback()
+{
+    overlays.erase(std::remove_if(overlays.begin(), overlays.end(), [](Overlay const& overlay) {
+        return overlay.component == nullptr;
+    }),
+        overlays.end());
+
+    if (overlays.empty()) {
+        enabled = false;
+        stopTimer();
+        return;
+    }
+
+    // Update the heatmap
+    for (auto& overlay : overlays) {
+        overlay.component->repaint();
+    }
+
+    if (++secondsSinceLastLog < logInterval)
+        return;
+
+    secondsSinceLastLog = 0;
+
+    auto report = getReport();
+    if (report.isNotEmpty())
+        overlays.front().log(report);
+
+    classStatistics.clear();
+    frameTimes.clear();
+}
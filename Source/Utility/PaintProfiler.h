@@ -0,0 +1,81 @@
+/*
+ // Copyright (c) 2021-2023 Timothy Schoen
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+
+#pragma once
+
+#include <map>
+
+// Developer tool that measures how long components take to paint and how often they repaint
+// Canvases that show the paint profiler overlay draw a heatmap of these measurements, and the frame times are logged to the console
+// Everything here runs on the message thread
+class PaintProfiler : public Timer
+    , public DeletedAtShutdown {
+public:
+    // Measurements for a single component, owned by that component
+    struct Statistics {
+        double lastPaintMs = 0.0;
+        double averagePaintMs = 0.0;
+        float paintsPerSecond = 0.0f;
+        int paintsInWindow = 0;
+        uint32 windowStart = 0;
+        uint32 lastPaintTime = 0;
+        int64 startTicks = 0;
+
+        bool isMeasuring() const { return startTicks != 0; }
+    };
+
+    ~PaintProfiler() override;
+
+    static bool isEnabled() { return enabled; }
+
+    // Call at the start of paint(), and endPaint at the end of paintOverChildren() to include the children
+    // This is called for every paint, so when no overlay is shown, it only checks a flag and doesn't create the profiler
+    static void startPaint(Statistics& statistics)
+    {
+        if (enabled)
+            statistics.startTicks = Time::getHighResolutionTicks();
+    }
+
+    // Only call this if statistics.isMeasuring()
+    void endPaint(Statistics& statistics, String const& className, bool isFrame = false);
+
+    // Canvases showing the overlay get repainted every second, and the log messages go to their console
+    void addOverlay(Component* overlay, std::function<void(String const&)> log);
+    void removeOverlay(Component* overlay);
+
+    // Green for components that are cheap to paint, red for ones that take a lot of time per second
+    static Colour getHeatColour(Statistics const& statistics);
+    static String getDescription(Statistics const& statistics);
+
+    void timerCallback() override;
+
+    JUCE_DECLARE_SINGLETON(PaintProfiler, false)
+
+private:
+    PaintProfiler() = default;
+
+    String getReport();
+
+    struct ClassStatistics {
+        int paints = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    struct Overlay {
+        Component::SafePointer<Component> component;
+        std::function<void(String const&)> log;
+    };
+
+    static constexpr int logInterval = 5;
+
+    static inline bool enabled = false;
+    int secondsSinceLastLog = 0;
+
+    std::map<String, ClassStatistics> classStatistics;
+    std::vector<double> frameTimes;
+    std::vector<Overlay> overlays;
+};
@@ -0,0 +1,114 @@
+/*
+ // Copyright (c) 2021-2023 Timothy Schoen
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+
+#pragma once
+
+#include "SignalTap.h"
+
+// Lock-free connection between the audio thread and a scope GUI
+// At about display rate, the audio thread reduces the last complete frame of the scope to the range of the points under every
+// pixel column, and publishes it through a triple buffer. The GUI only picks up the latest frame on its timer
+class ScopeTap : public SignalTap {
+public:
+    // Same as the capacity of the scope buffers in cyclone and ELSE
+    static constexpr int maxPoints = 1024;
+
+    enum Mode {
+        Off = 0,
+        Horizontal, // first signal over time
+        Vertical,   // second signal over time, from top to bottom
+        XY
+    };
+
+    struct Frame {
+        // The minimum and maximum under every column when isEnvelope is set, otherwise the value of every point
+        // In XY mode, these are the x and y values of every point
+        std::array<float, maxPoints> first;
+        std::array<float, maxPoints> second;
+        int size = 0;
+        bool isEnvelope = false;
+
+        int mode = Off;
+        float min = -1.0f;
+        float max = 1.0f;
+    };
+
+    // Calls push with the buffers of the Pd object, called by the audio thread
+    std::function<void()> capture;
+
+    void process() override
+    {
+        capture();
+    }
+
+    // Number of pixels the signal can be drawn over, set by the GUI
+    void setResolution(int width, int height)
+    {
+        horizontalResolution = jlimit(1, maxPoints, width);
+        verticalResolution = jlimit(1, maxPoints, height);
+    }
+
+    // Audio thread only
+    void push(float const* x, float const* y, int numPoints, int mode, float min, float max)
+    {
+        fillFrame(frames.getWriteBuffer(), x, y, numPoints, mode, min, max);
+        frames.publish();
+    }
+
+    // Message thread only, returns false when no frame arrived since the last call
+    bool update() { return frames.update(); }
+
+    Frame const& getFrame() const { return frames.getReadBuffer(); }
+
+private:
+    void fillFrame(Frame& frame, float const* x, float const* y, int numPoints, int mode, float min, float max)
+    {
+        frame.mode = mode;
+        frame.min = min;
+        frame.max = max;
+        frame.isEnvelope = false;
+        frame.size = 0;
+
+        numPoints = jlimit(0, maxPoints, numPoints);
+        if (mode == Off || numPoints == 0)
+            return;
+
+        if (mode == XY) {
+            std::copy(x, x + numPoints, frame.first.begin());
+            std::copy(y, y + numPoints, frame.second.begin());
+            frame.size = numPoints;
+            return;
+        }
+
+        auto const* signal = mode == Vertical ? y : x;
+        auto const numColumns = mode == Vertical ? verticalResolution.load() : horizontalResolution.load();
+
+        if (numPoints <= numColumns) {
+            std::copy(signal, signal + numPoints, frame.first.begin());
+            std::copy(signal, signal + numPoints, frame.second.begin());
+            frame.size = numPoints;
+            return;
+        }
+
+        // Every column includes the first point of the next one, so the columns connect like the lines between points would
+        for (int column = 0; column < numColumns; column++) {
+            auto const start = column * numPoints / numColumns;
+            auto const end = std::min(numPoints, (column + 1) * numPoints / numColumns + 1);
+            auto const range = FloatVectorOperations::findMinAndMax(signal + start, end - start);
+
+            frame.first[column] = range.getStart();
+            frame.second[column] = range.getEnd();
+        }
+
+        frame.size = numColumns;
+        frame.isEnvelope = true;
+    }
+
+    TripleBuffer<Frame> frames;
+
+    std::atomic<int> horizontalResolution = 1;
+    std::atomic<int> verticalResolution = 1;
+};
@@ -94,6 +94,9 @@ private:
         { "oversampling", var(0) },
         { "protected", var(1) },
         { "internal_synth", var(0) },
+        { "dsp_crossfade", var(true) },
+        { "batched_connections", var(false) },
+        { "low_detail_zoomed_out", var(true) },
         { "grid_enabled", var(1) },
         { "grid_type", var(6) },
         { "grid_size", var(20) },
@@ -0,0 +1,89 @@
+/*
+ // Copyright (c) 2021-2023 Timothy Schoen
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+
+#pragma once
+
+#include <array>
+
+// Lets one thread hand the latest version of some data to another thread, without either of them ever waiting
+// The writer fills its own buffer and swaps it with the middle one, the reader swaps the middle one with its own when it was updated
+template<typename T>
+class TripleBuffer {
+public:
+    explicit TripleBuffer(T const& initial = {})
+        : buffers { initial, initial, initial }
+    {
+    }
+
+    // Writer only
+    T& getWriteBuffer() { return buffers[writeIndex]; }
+
+    void publish()
+    {
+        writeIndex = middle.exchange(writeIndex | newDataFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Reader only, returns false when nothing was published since the last call
+    bool update()
+    {
+        if ((middle.load(std::memory_order_relaxed) & newDataFlag) == 0)
+            return false;
+
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    T const& getReadBuffer() const { return buffers[readIndex]; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int newDataFlag = 4;
+
+    std::array<T, 3> buffers;
+    int writeIndex = 0;
+    int readIndex = 1;
+    std::atomic<int> middle = 2;
+};
+
+// Something a GUI object watches in its Pd object, copied by the audio thread at about display rate
+// Taps are registered with PluginProcessor::addSignalTap, so monitoring never needs the audio lock on the message thread
+class SignalTap {
+public:
+    virtual ~SignalTap() = default;
+
+    // Called by the audio thread, with the audio lock held
+    virtual void process() = 0;
+};
+
+// A few values, like the current value of numbox~ or the levels of vu
+class ValueTap : public SignalTap {
+public:
+    static constexpr int maxValues = 4;
+    using Values = std::array<float, maxValues>;
+
+    // The values to show until the audio thread copied them for the first time
+    explicit ValueTap(Values initial = {})
+        : values(initial)
+    {
+    }
+
+    // Copies the values out of the Pd object, called by the audio thread
+    std::function<void(Values&)> capture;
+
+    void process() override
+    {
+        capture(values.getWriteBuffer());
+        values.publish();
+    }
+
+    // Message thread only, returns false when the values weren't copied again since the last call
+    bool update() { return values.update(); }
+
+    float operator[](int index) const { return values.getReadBuffer()[index]; }
+
+private:
+    TripleBuffer<Values> values;
+};
@@ -0,0 +1,153 @@
+/*
+ // Copyright (c) 2021-2023 Timothy Schoen
+ // For information on usage and redistribution, and for a DISCLAIMER OF ALL
+ // WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+ */
+
+#pragma once
+
+#include <unordered_map>
+
+// Uniform grid that keeps track of the bounds of items, to quickly find the items in an area
+// Items that span multiple cells are stored in each of those cells
+template<typename ItemType>
+class SpatialIndex {
+public:
+    explicit SpatialIndex(int cellSizeToUse = 128)
+        : cellSize(cellSizeToUse)
+    {
+    }
+
+    // Adds an item, or updates its bounds if it's already in the index
+    void update(ItemType* item, Rectangle<int> bounds)
+    {
+        auto existing = items.find(item);
+        if (existing == items.end()) {
+            items[item] = bounds;
+            addToCells(item, getCellRange(bounds));
+            return;
+        }
+
+        if (existing->second == bounds)
+            return;
+
+        auto oldRange = getCellRange(existing->second);
+        auto newRange = getCellRange(bounds);
+        existing->second = bounds;
+
+        // Small moves usually stay inside the same cells
+        if (oldRange == newRange)
+            return;
+
+        removeFromCells(item, oldRange);
+        addToCells(item, newRange);
+    }
+
+    void remove(ItemType* item)
+    {
+        auto existing = items.find(item);
+        if (existing == items.end())
+            return;
+
+        removeFromCells(item, getCellRange(existing->second));
+        items.erase(existing);
+    }
+
+    void clear()
+    {
+        items.clear();
+        cells.clear();
+    }
+
+    // Returns all items with bounds that intersect with the area, each item only once
+    Array<ItemType*> query(Rectangle<int> area) const
+    {
+        Array<ItemType*> result;
+        auto const range = getCellRange(area);
+
+        for (int x = range.x1; x <= range.x2; x++) {
+            for (int y = range.y1; y <= range.y2; y++) {
+                auto cell = cells.find(getKey(x, y));
+                if (cell == cells.end())
+                    continue;
+
+                for (auto* item : cell->second) {
+                    auto const& bounds = items.at(item);
+                    if (!bounds.intersects(area))
+                        continue;
+
+                    // Only add the item in the first cell that contains both the item and the area, to prevent duplicates
+                    auto const itemRange = getCellRange(bounds);
+                    if (std::max(itemRange.x1, range.x1) == x && std::max(itemRange.y1, range.y1) == y) {
+                        result.add(item);
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+    Rectangle<int> getBounds(ItemType* item) const
+    {
+        auto existing = items.find(item);
+        return existing != items.end() ? existing->second : Rectangle<int>();
+    }
+
+private:
+    struct CellRange {
+        int x1, y1, x2, y2;
+
+        bool operator==(CellRange const& other) const
+        {
+            return x1 == other.x1 && y1 == other.y1 && x2 == other.x2 && y2 == other.y2;
+        }
+    };
+
+    int getCell(int position) const
+    {
+        // Round towards negative infinity, so negative coordinates end up in the right cell
+        return position >= 0 ? position / cellSize : (position - cellSize + 1) / cellSize;
+    }
+
+    CellRange getCellRange(Rectangle<int> bounds) const
+    {
+        return { getCell(bounds.getX()), getCell(bounds.getY()), getCell(bounds.getRight()), getCell(bounds.getBottom()) };
+    }
+
+    static int64 getKey(int x, int y)
+    {
+        return (static_cast<int64>(x) << 32) | static_cast<uint32>(y);
+    }
+
+    void addToCells(ItemType* item, CellRange range)
+    {
+        for (int x = range.x1; x <= range.x2; x++) {
+            for (int y = range.y1; y <= range.y2; y++) {
+                cells[getKey(x, y)].push_back(item);
+            }
+        }
+    }
+
+    void removeFromCells(ItemType* item, CellRange range)
+    {
+        for (int x = range.x1; x <= range.x2; x++) {
+            for (int y = range.y1; y <= range.y2; y++) {
+                auto cell = cells.find(getKey(x, y));
+                if (cell == cells.end())
+                    continue;
+
+                auto& cellItems = cell->second;
+                cellItems.erase(std::remove(cellItems.begin(), cellItems.end(), item), cellItems.end());
+
+                if (cellItems.empty())
+                    cells.erase(cell);
+            }
+        }
+    }
+
+    int const cellSize;
+
+    std::unordered_map<ItemType*, Rectangle<int>> items;
+    std::unordered_map<int64, std::vector<ItemType*>> cells;
+};
@@ -16,6 +16,7 @@
 
 #include <JuceHeader.h>
 #include "Utility/HashUtils.h"
+#include "Utility/DropShadowCache.h"
 
 #if JUCE_WINDOWS
 // Enable for JUCE >=7.0.6
@@ -24,6 +25,7 @@
 #endif
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_dsp/juce_dsp.h>
 
 class StackShadow {
 
@@ -65,9 +67,70 @@ class StackShadow {
         24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24
     };
 
-    static ImageCache dropShadowCache;
+    static inline DropShadowCache dropShadowCache;
+
+    static inline constexpr int numBlurThreads = 4;
+
+    // Created on first use, so the threads aren't started when the plugin is loaded
+    static ThreadPool& getBlurThreadPool()
+    {
+        static ThreadPool blurThreadPool(numBlurThreads);
+        return blurThreadPool;
+    }
+
+    // Identifies the shadow image for a path, independent of where the path is
+    // Only the shape relative to the path bounds, the sub-pixel position and the blur parameters matter
+    static uint64 getShadowKey(Path const& path, int radius, int spread)
+    {
+        auto origin = path.getBounds().getTopLeft();
+
+        // 64-bit FNV-1a
+        uint64 result = 0xcbf29ce484222325ull;
+        auto addToKey = [&result](float value) {
+            auto quantised = static_cast<uint32>(roundToInt(value * 64.0f));
+            for (int i = 0; i < 4; i++) {
+                result ^= (quantised >> (i * 8)) & 0xff;
+                result *= 0x100000001b3ull;
+            }
+        };
+
+        addToKey(static_cast<float>(radius));
+        addToKey(static_cast<float>(spread));
+        addToKey(origin.x - std::floor(origin.x));
+        addToKey(origin.y - std::floor(origin.y));
+
+        Path::Iterator it(path);
+        while (it.next()) {
+            addToKey(static_cast<float>(it.elementType));
+
+            switch (it.elementType) {
+            case Path::Iterator::cubicTo:
+                addToKey(it.x3 - origin.x);
+                addToKey(it.y3 - origin.y);
+                [[fallthrough]];
+            case Path::Iterator::quadraticTo:
+                addToKey(it.x2 - origin.x);
+                addToKey(it.y2 - origin.y);
+                [[fallthrough]];
+            case Path::Iterator::startNewSubPath:
+            case Path::Iterator::lineTo:
+                addToKey(it.x1 - origin.x);
+                addToKey(it.y1 - origin.y);
+                break;
+            default:
+                break;
+            }
+        }
+
+        return result;
+    }
 
 public:
+    static DropShadowCache& getShadowCache()
+    {
+        return dropShadowCache;
+    }
+
     static void applyStackBlurBW(Image& img, unsigned int radius)
     {
         auto const w = (unsigned int)img.getWidth();
@@ -684,7 +747,8 @@ public:
         }
     }
 
-    static void applyStackBlur(Image& img, int radius)
+    // Reference implementation, kept for testing the vectorised version against
+    static void applyStackBlurScalar(Image& img, int radius)
     {
         if (img.getFormat() == Image::ARGB)
             applyStackBlurARGB(img, (unsigned int)radius);
@@ -694,6 +758,212 @@ public:
             applyStackBlurBW(img, (unsigned int)radius);
     }
 
+    // Runs the same recurrence as the scalar versions, but for several lines at once: each SIMD lane holds the sums for one line
+    // A line is one colour channel of a row or column, so a single row of an ARGB image fills 4 lanes
+    // Large images are split over a thread pool. The output is exactly the same as applyStackBlurScalar
+    static void applyStackBlur(Image& img, int radius)
+    {
+        auto const clampedRadius = jlimit(2u, 254u, (unsigned int)radius);
+
+        int numChannels = 0;
+        if (img.getFormat() == Image::ARGB)
+            numChannels = 4;
+        if (img.getFormat() == Image::RGB)
+            numChannels = 3;
+        if (img.getFormat() == Image::SingleChannel)
+            numChannels = 1;
+
+        // The vectorised version uses 32-bit lanes, fall back to the scalar version if the sums could overflow
+        auto const maxProduct = (uint64)255 * (clampedRadius + 1) * (clampedRadius + 1) * stackblur_mul[clampedRadius];
+        if (numChannels == 0 || maxProduct > std::numeric_limits<uint32>::max()) {
+            applyStackBlurScalar(img, radius);
+            return;
+        }
+
+        auto const w = img.getWidth();
+        auto const h = img.getHeight();
+
+        Image::BitmapData data(img, Image::BitmapData::readWrite);
+
+        std::vector<uint8*> lines;
+        lines.reserve(static_cast<size_t>(std::max(w, h) * numChannels));
+
+        // Rows
+        for (int y = 0; y < h; y++) {
+            for (int c = 0; c < numChannels; c++) {
+                lines.push_back(data.getLinePointer(y) + c);
+            }
+        }
+        blurLinesInParallel(lines, w, data.pixelStride, clampedRadius);
+
+        // Columns, neighbouring lanes are next to each other in memory
+        lines.clear();
+        for (int x = 0; x < w; x++) {
+            for (int c = 0; c < numChannels; c++) {
+                lines.push_back(data.getLinePointer(0) + x * data.pixelStride + c);
+            }
+        }
+        blurLinesInParallel(lines, h, data.lineStride, clampedRadius);
+    }
+
+    static void blurLinesInParallel(std::vector<uint8*>& lines, int length, int step, unsigned int radius)
+    {
+        constexpr int numLanes = static_cast<int>(dsp::SIMDRegister<uint32>::SIMDNumElements);
+        constexpr int minSamplesPerJob = 1 << 16;
+
+        auto const numLines = static_cast<int>(lines.size());
+        auto const numGroups = (numLines + numLanes - 1) / numLanes;
+        auto const numJobs = jlimit(1, numBlurThreads + 1, (numLines * length) / minSamplesPerJob);
+
+        if (numJobs <= 1) {
+            blurLines(lines.data(), numLines, length, step, radius);
+            return;
+        }
+
+        // Split into jobs of whole lane groups, and do the first one on this thread
+        auto const groupsPerJob = (numGroups + numJobs - 1) / numJobs;
+        auto const linesPerJob = groupsPerJob * numLanes;
+
+        // Set the job count before starting any job, so it can't reach zero before all jobs are added
+        auto const numPoolJobs = (numLines - 1) / linesPerJob;
+        std::atomic<int> jobsLeft = numPoolJobs;
+        WaitableEvent jobsDone;
+
+        auto& blurThreadPool = getBlurThreadPool();
+        for (int first = linesPerJob; first < numLines; first += linesPerJob) {
+            blurThreadPool.addJob([&lines, &jobsLeft, &jobsDone, first, count = std::min(linesPerJob, numLines - first), length, step, radius]() {
+                blurLines(lines.data() + first, count, length, step, radius);
+                if (--jobsLeft == 0)
+                    jobsDone.signal();
+            });
+        }
+
+        blurLines(lines.data(), std::min(linesPerJob, numLines), length, step, radius);
+
+        // Always wait for the signal, so the event can't be destroyed while a job is still signalling it
+        if (numPoolJobs > 0)
+            jobsDone.wait();
+    }
+
+    static void blurLines(uint8* const* lines, int numLines, int length, int step, unsigned int radius)
+    {
+        using Vec = dsp::SIMDRegister<uint32>;
+        constexpr int numLanes = static_cast<int>(Vec::SIMDNumElements);
+
+        std::vector<Vec> stack(radius * 2 + 1);
+
+        // The lanes are interleaved into an aligned buffer first, so the blur itself only does vector loads and stores
+        std::vector<Vec> lineBuffer(static_cast<size_t>(length), Vec::expand(0));
+        auto* interleaved = reinterpret_cast<uint32*>(lineBuffer.data());
+
+        for (int first = 0; first < numLines; first += numLanes) {
+            auto const* lanes = lines + first;
+            auto const numActiveLanes = std::min(numLanes, numLines - first);
+
+            // Usually the lanes are neighbouring bytes, like the channels of a pixel or neighbouring columns
+            // Then we can copy them as a block, instead of gathering them one by one
+            bool isContiguous = numActiveLanes == numLanes;
+            for (int l = 1; l < numActiveLanes && isContiguous; l++)
+                isContiguous = lanes[l] == lanes[0] + l;
+
+            if (isContiguous) {
+                for (int x = 0; x < length; x++) {
+                    auto const* src = lanes[0] + x * step;
+                    for (int l = 0; l < numLanes; l++) {
+                        interleaved[x * numLanes + l] = src[l];
+                    }
+                }
+            } else {
+                for (int x = 0; x < length; x++) {
+                    for (int l = 0; l < numActiveLanes; l++) {
+                        interleaved[x * numLanes + l] = lanes[l][x * step];
+                    }
+                }
+            }
+
+            blurLanes(stack.data(), lineBuffer.data(), length, radius);
+
+            if (isContiguous) {
+                for (int x = 0; x < length; x++) {
+                    auto* dst = lanes[0] + x * step;
+                    for (int l = 0; l < numLanes; l++) {
+                        dst[l] = static_cast<uint8>(interleaved[x * numLanes + l]);
+                    }
+                }
+            } else {
+                for (int x = 0; x < length; x++) {
+                    for (int l = 0; l < numActiveLanes; l++) {
+                        lanes[l][x * step] = static_cast<uint8>(interleaved[x * numLanes + l]);
+                    }
+                }
+            }
+        }
+    }
+
+    // The stack blur recurrence, blurs the line in-place in the same order as the scalar version
+    template<typename Vec>
+    static void blurLanes(Vec* stack, Vec* line, int length, unsigned int radius)
+    {
+        auto const wm = length - 1;
+        auto const div = static_cast<int>(radius * 2 + 1);
+        auto const r = static_cast<int>(radius);
+        auto const mulSum = Vec::expand(stackblur_mul[radius]);
+        auto const shrSum = static_cast<int>(stackblur_shr[radius]);
+
+        auto sum = Vec::expand(0);
+        auto sumIn = Vec::expand(0);
+        auto sumOut = Vec::expand(0);
+
+        auto firstValue = line[0];
+        for (int i = 0; i <= r; ++i) {
+            stack[i] = firstValue;
+            sum += firstValue * Vec::expand(static_cast<uint32>(i + 1));
+            sumOut += firstValue;
+        }
+
+        for (int i = 1; i <= r; ++i) {
+            auto value = line[std::min(i, wm)];
+            stack[i + r] = value;
+            sum += value * Vec::expand(static_cast<uint32>(r + 1 - i));
+            sumIn += value;
+        }
+
+        auto sp = r;
+        auto xp = std::min(r, wm);
+
+        for (int x = 0; x <= wm; ++x) {
+            // SIMDRegister has no shift operator, so shift the lanes one by one
+            auto const product = sum * mulSum;
+            for (size_t l = 0; l < Vec::SIMDNumElements; l++) {
+                line[x].set(l, product.get(l) >> shrSum);
+            }
+
+            sum -= sumOut;
+
+            auto stackStart = sp + div - r;
+            if (stackStart >= div)
+                stackStart -= div;
+
+            sumOut -= stack[stackStart];
+
+            if (xp < wm)
+                ++xp;
+
+            // Because this is in-place, it can read a value we just wrote, just like the scalar version
+            auto value = line[xp];
+            stack[stackStart] = value;
+
+            sumIn += value;
+            sum += sumIn;
+
+            if (++sp >= div)
+                sp = 0;
+
+            sumOut += stack[sp];
+            sumIn -= stack[sp];
+        }
+    }
+
     static void renderDropShadow(Graphics& g, Path const& path, Colour color, int const radius = 1, Point<int> const offset = { 0, 0 }, int spread = 0, float scale = 1.0f)
     {
         if (radius < 1)
@@ -711,13 +981,16 @@ public:
         if (area.getWidth() < 2 || area.getHeight() < 2)
             return;
 
-        auto fastHash = hash(String(path.getBounds().toString() + String(radius) + String(offset.x) + String(offset.y) + String(spread)));
+        if (spread != 0)
+            area.expand(spread, spread);
 
-        Image renderedPath = dropShadowCache.getFromHashCode(fastHash);
+        // Shadows for paths with the same shape are shared, no matter where they are drawn
+        auto key = getShadowKey(path, radius, spread);
+
+        Image renderedPath = dropShadowCache.get(key);
         if (renderedPath.isNull()) {
             auto spreadPath = Path(path);
             if (spread != 0) {
-                area.expand(spread, spread);
                 auto bounds = path.getBounds().expanded(spread);
                 spreadPath.scaleToFit(bounds.getX(), bounds.getY(), bounds.getWidth(), bounds.getHeight(), true);
             }
@@ -726,10 +999,7 @@ public:
             g2.setColour(Colours::white);
             g2.fillPath((spread != 0) ? spreadPath : path, AffineTransform::translation((float)(offset.x - area.getX()), (float)(offset.y - area.getY())));
             applyStackBlur(renderedPath, radius);
-            dropShadowCache.addImageToCache(renderedPath, fastHash);
-
-            // we probably don't need this
-            // dropShadowCache.releaseUnusedImages();
+            dropShadowCache.add(key, renderedPath);
         }
         g.setColour(color);
         g.drawImageAt(renderedPath, area.getX(), area.getY(), true);
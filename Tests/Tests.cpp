@@ -5,6 +5,9 @@
 #define Rectangle juce::Rectangle
 
 #include <PluginProcessor.h>
+#include <Utility/StackShadow.h>
+#include <Utility/MinMaxPyramid.h>
+#include <Utility/DocumentationDatabase.h>
 
 
 #include <juce_core/system/juce_TargetPlatform.h>
@@ -77,3 +80,159 @@ TEST_CASE("Create and delete objects", "[name]")
     
     StopApplicationAfter(1500);
 }
+
+static Image createBlurTestImage(Image::PixelFormat format, int width, int height, int seed)
+{
+    Image image(format, width, height, true, SoftwareImageType());
+    Image::BitmapData data(image, Image::BitmapData::readWrite);
+
+    Random rng(seed);
+    for (int y = 0; y < height; y++) {
+        auto* line = data.getLinePointer(y);
+        for (int x = 0; x < width * data.pixelStride; x++) {
+            line[x] = static_cast<uint8>(rng.nextInt(256));
+        }
+    }
+
+    return image;
+}
+
+static bool imagesAreIdentical(Image const& a, Image const& b)
+{
+    Image::BitmapData dataA(a, Image::BitmapData::readOnly);
+    Image::BitmapData dataB(b, Image::BitmapData::readOnly);
+
+    for (int y = 0; y < a.getHeight(); y++) {
+        if (memcmp(dataA.getLinePointer(y), dataB.getLinePointer(y), static_cast<size_t>(a.getWidth() * dataA.pixelStride)) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+TEST_CASE("Vectorised stack blur matches the scalar version", "[stackblur]")
+{
+    int seed = 0;
+    for (auto format : { Image::SingleChannel, Image::RGB, Image::ARGB }) {
+        // Includes tiny images, odd sizes that don't fill all SIMD lanes, and images large enough to use the thread pool
+        for (auto size : { Point<int>(1, 1), Point<int>(2, 3), Point<int>(17, 5), Point<int>(64, 64), Point<int>(301, 199), Point<int>(1024, 768) }) {
+            for (auto radius : { -3, 1, 2, 5, 12, 30, 120, 254, 300 }) {
+                auto scalar = createBlurTestImage(format, size.x, size.y, seed++);
+                auto vectorised = scalar.createCopy();
+
+                StackShadow::applyStackBlurScalar(scalar, radius);
+                StackShadow::applyStackBlur(vectorised, radius);
+
+                INFO("format: " << format << ", size: " << size.x << "x" << size.y << ", radius: " << radius);
+                CHECK(imagesAreIdentical(scalar, vectorised));
+            }
+        }
+    }
+}
+
+TEST_CASE("Min/max pyramid matches the samples", "[minmaxpyramid]")
+{
+    auto random = Random(1);
+    for (size_t size : { 1, 63, 64, 65, 1000, 4097, 100003 }) {
+        std::vector<float> samples(size);
+        for (auto& sample : samples)
+            sample = random.nextFloat() * 2.0f - 1.0f;
+
+        MinMaxPyramid peaks;
+        peaks.rebuild(samples.data(), samples.size());
+
+        for (int i = 0; i < 500; i++) {
+            auto start = static_cast<size_t>(random.nextInt(static_cast<int>(size)));
+            auto end = start + 1 + static_cast<size_t>(random.nextInt(static_cast<int>(size - start)));
+
+            // Change a sample now and then, to check that updates reach all levels
+            if (i % 3 == 0) {
+                samples[start] = random.nextFloat() * 4.0f - 2.0f;
+                peaks.update(samples.data(), samples.size(), start, start + 1);
+            }
+
+            auto range = peaks.getRange(samples.data(), start, end);
+
+            INFO("size: " << size << ", range: " << start << " to " << end);
+            CHECK(range.min == *std::min_element(samples.begin() + start, samples.begin() + end));
+            CHECK(range.max == *std::max_element(samples.begin() + start, samples.begin() + end));
+        }
+    }
+}
+
+TEST_CASE("Documentation index finds objects by what they do", "[documentationindex]")
+{
+    CHECK(DocumentationIndex::tokenise("Sends messages to the outlets") == StringArray { "send", "message", "outlet" });
+
+    auto addObject = [](ValueTree& documentation, String const& name, String const& description) {
+        ValueTree object("object");
+        object.setProperty("name", name, nullptr);
+        object.setProperty("description", description, nullptr);
+        documentation.appendChild(object, nullptr);
+    };
+
+    ValueTree documentation("documentation");
+    addObject(documentation, "osc~", "cosine wave oscillator");
+    addObject(documentation, "phasor~", "sawtooth oscillator");
+    addObject(documentation, "print", "prints messages to the console");
+    addObject(documentation, "send", "sends messages without a connection");
+
+    DocumentationIndex index(documentation);
+
+    CHECK(index.search("oscillator") == StringArray { "osc~", "phasor~" });
+    CHECK(index.search("sawtooth oscillator") == StringArray { "phasor~" });
+    CHECK(index.search("message ") == StringArray { "send", "print" });
+    CHECK(index.search("osc") == StringArray { "osc~", "phasor~" });
+    CHECK(index.search("the") == StringArray {});
+}
+
+TEST_CASE("Lazily decoded documentation matches the full tree", "[documentationdatabase]")
+{
+    auto documentationTree = ValueTree::readFromData(BinaryData::Documentation_bin, BinaryData::Documentation_binSize);
+    DocumentationDatabase documentation;
+
+    REQUIRE(documentationTree.getNumChildren() > 0);
+
+    for (auto object : documentationTree) {
+        auto name = object.getProperty("name").toString();
+        INFO("object: " << name);
+        CHECK(documentation.getObjectInfo(name).isEquivalentTo(documentationTree.getChildWithProperty("name", name)));
+    }
+
+    CHECK(!documentation.getObjectInfo("not-an-object").isValid());
+}
+
+TEST_CASE("Stack blur benchmark", "[.][benchmark]")
+{
+    // About the size of a window shadow
+    auto singleChannel = createBlurTestImage(Image::SingleChannel, 1600, 1000, 1);
+    auto argb = createBlurTestImage(Image::ARGB, 1600, 1000, 2);
+
+    BENCHMARK("Scalar, single channel")
+    {
+        auto image = singleChannel.createCopy();
+        StackShadow::applyStackBlurScalar(image, 12);
+        return image;
+    };
+
+    BENCHMARK("Vectorised, single channel")
+    {
+        auto image = singleChannel.createCopy();
+        StackShadow::applyStackBlur(image, 12);
+        return image;
+    };
+
+    BENCHMARK("Scalar, ARGB")
+    {
+        auto image = argb.createCopy();
+        StackShadow::applyStackBlurScalar(image, 12);
+        return image;
+    };
+
+    BENCHMARK("Vectorised, ARGB")
+    {
+        auto image = argb.createCopy();
+        StackShadow::applyStackBlur(image, 12);
+        return image;
+    };
+}